@@ -29,6 +29,7 @@
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Analyses/InducedAccelerationsSolver.h>
+#include <OpenSim/Analyses/InducedAccelerations.h>
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -37,6 +38,9 @@ using namespace std;
 // Prototypes
 void testDoublePendulumWithSolver();
 void testDoublePendulum();
+void testDoublePendulumThreaded();
+void testRunningThreaded();
+void checkSameAsSerial(const Storage& serial, const Storage& threaded);
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity);
 
 int main()
@@ -49,11 +53,17 @@ int main()
         // check that analysis version still works
         testDoublePendulum();
 
+        // contributors solved on several threads match a serial solution
+        testDoublePendulumThreaded();
+
         AnalyzeTool analyze("subject02_Setup_IAA_02_232.xml");
         analyze.run();
         Storage result1("ResultsInducedAccelerations/subject02_running_arms_InducedAccelerations_center_of_mass.sto"), standard1("std_subject02_running_arms_InducedAccelerations_CENTER_OF_MASS.sto");
         CHECK_STORAGE_AGAINST_STANDARD(result1, standard1, Array<double>(0.15, result1.getSmallestNumberOfStates()), __FILE__, __LINE__, "Induced Accelerations of Running failed");
         cout << "Induced Accelerations of Running passed\n" << endl;
+
+        // a muscle model asked to use threads matches the serial solution
+        testRunningThreaded();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -217,6 +227,64 @@ void testDoublePendulum()
     cout << "Analysis computed " << nt << " frames in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
 }
 
+void testDoublePendulumThreaded()
+{
+    // Run the analysis with the contributors solved serially and then on
+    // four threads, and require identical results.
+    int numThreads[2] = {1, 4};
+    for(int k=0; k<2; ++k){
+        AnalyzeTool analyze("double_pendulum_Setup_IAA.xml");
+        analyze.setName("double_pendulum_threads" + to_string(numThreads[k]));
+        InducedAccelerations& iaa = dynamic_cast<InducedAccelerations&>(
+            analyze.getAnalysisSet().get("InducedAccelerations"));
+        iaa.setNumThreads(numThreads[k]);
+        analyze.run();
+    }
+
+    const char* coords[2] = {"q1", "q2"};
+    for(int c=0; c<2; ++c){
+        string suffix = string("_InducedAccelerations_") + coords[c] + ".sto";
+        Storage serial("ResultsInducedAccelerations/double_pendulum_threads1" + suffix);
+        Storage threaded("ResultsInducedAccelerations/double_pendulum_threads4" + suffix);
+        checkSameAsSerial(serial, threaded);
+    }
+    cout << "Induced Accelerations of double pendulum on threads passed\n" << endl;
+}
+
+void testRunningThreaded()
+{
+    // The muscles' paths are computed in the model, so the contributors of
+    // the running model are solved on one thread however many are asked for.
+    AnalyzeTool analyze("subject02_Setup_IAA_02_232.xml");
+    analyze.setName("subject02_running_arms_threads4");
+    InducedAccelerations& iaa = dynamic_cast<InducedAccelerations&>(
+        analyze.getAnalysisSet().get("InducedAccelerations"));
+    iaa.setNumThreads(4);
+    analyze.run();
+
+    Storage serial("ResultsInducedAccelerations/subject02_running_arms_InducedAccelerations_center_of_mass.sto");
+    Storage threaded("ResultsInducedAccelerations/subject02_running_arms_threads4_InducedAccelerations_center_of_mass.sto");
+    checkSameAsSerial(serial, threaded);
+    cout << "Induced Accelerations of Running on threads passed\n" << endl;
+}
+
+void checkSameAsSerial(const Storage& serial, const Storage& threaded)
+{
+    ASSERT(serial.getSize() == threaded.getSize(), __FILE__, __LINE__,
+        "Threaded Induced Accelerations has a different number of rows");
+    ASSERT(serial.getColumnLabels() == threaded.getColumnLabels(), __FILE__, __LINE__,
+        "Threaded Induced Accelerations has different columns");
+    for(int i=0; i<serial.getSize(); ++i){
+        const Array<double>& expected = serial.getStateVector(i)->getData();
+        const Array<double>& found = threaded.getStateVector(i)->getData();
+        ASSERT(serial.getStateVector(i)->getTime() ==
+               threaded.getStateVector(i)->getTime(), __FILE__, __LINE__,
+            "Threaded Induced Accelerations times differ");
+        for(int j=0; j<expected.getSize(); ++j)
+            ASSERT(expected[j] == found[j], __FILE__, __LINE__,
+                "Threaded Induced Accelerations differ from serial");
+    }
+}
 
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity)
 {   
@@ -28,6 +28,45 @@
 using namespace OpenSim;
 using namespace std;
 
+void testDoublePendulum3DThreaded();
+void testUnlistedStorageThreaded();
+void checkSameAsSerial(const Storage& serial, const Storage& threaded);
+
+// An analysis that, like AnalysisPlugin_Template, records into a storage
+// that it does not list in getStorageList().
+class UnlistedCoordinates : public Analysis {
+OpenSim_DECLARE_CONCRETE_OBJECT(UnlistedCoordinates, Analysis);
+public:
+    UnlistedCoordinates() { setName("UnlistedCoordinates"); }
+
+    int begin(SimTK::State& s) override {
+        if(!proceed()) return 0;
+        Array<string> labels;
+        labels.append("time");
+        for(int i=0; i<s.getNQ(); ++i) labels.append("q" + to_string(i));
+        _store.setColumnLabels(labels);
+        _store.reset(s.getTime());
+        if(_store.getSize()<=0) record(s);
+        return 0;
+    }
+    int step(const SimTK::State& s, int stepNumber) override {
+        if(proceed(stepNumber)) record(s);
+        return 0;
+    }
+    int printResults(const string& aBaseName, const string& aDir,
+            double aDT, const string& aExtension) override {
+        Storage::printResult(&_store, aBaseName + "_" + getName() + "_q",
+            aDir, aDT, aExtension);
+        return 0;
+    }
+
+private:
+    void record(const SimTK::State& s) {
+        _store.append(s.getTime(), s.getNQ(), &s.getQ()[0]);
+    }
+    Storage _store;
+};
+
 int main()
 {
     try {
@@ -42,6 +81,12 @@ int main()
         Storage result2("DoublePendulum3D_JointReaction_ReactionLoads.sto"), standard2("std_DoublePendulum3D_JointReaction_ReactionLoads.sto");
         CHECK_STORAGE_AGAINST_STANDARD(result2, standard2, Array<double>(1e-5, 24), __FILE__, __LINE__, "DoublePendulum3D failed");
         cout << "DoublePendulum3D passed" << endl;
+
+        testDoublePendulum3DThreaded();
+        cout << "DoublePendulum3D on threads passed" << endl;
+
+        testUnlistedStorageThreaded();
+        cout << "Analysis with unlisted storage on threads passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -50,3 +95,66 @@ int main()
     cout << "Done" << endl;
     return 0;
 }
+
+void testDoublePendulum3DThreaded()
+{
+    // Analyze the frames serially and then on four threads, with analyses
+    // that keep their storages as members, and require identical results.
+    int numThreads[2] = {1, 4};
+    for(int k=0; k<2; ++k){
+        AnalyzeTool analyze("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze.setName("DoublePendulum3D_threads" + to_string(numThreads[k]));
+        analyze.setNumThreads(numThreads[k]);
+        BodyKinematics* bodyKinematics = new BodyKinematics();
+        bodyKinematics->setName("BodyKinematics");
+        analyze.getAnalysisSet().adoptAndAppend(bodyKinematics);
+        analyze.run();
+    }
+
+    const char* suffixes[4] = {"_JointReaction_ReactionLoads.sto",
+        "_BodyKinematics_acc_global.sto", "_BodyKinematics_vel_global.sto",
+        "_BodyKinematics_pos_global.sto"};
+    for(int f=0; f<4; ++f){
+        Storage serial(string("DoublePendulum3D_threads1") + suffixes[f]);
+        Storage threaded(string("DoublePendulum3D_threads4") + suffixes[f]);
+        checkSameAsSerial(serial, threaded);
+    }
+}
+
+void testUnlistedStorageThreaded()
+{
+    // Rows that an analysis keeps in a storage it does not list cannot be
+    // merged from other threads; they must not be lost.
+    int numThreads[2] = {1, 4};
+    for(int k=0; k<2; ++k){
+        AnalyzeTool analyze("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze.setName("DoublePendulum3D_unlisted_threads" + to_string(numThreads[k]));
+        analyze.setNumThreads(numThreads[k]);
+        analyze.getAnalysisSet().adoptAndAppend(new UnlistedCoordinates());
+        analyze.run();
+    }
+
+    Storage serial("DoublePendulum3D_unlisted_threads1_UnlistedCoordinates_q.sto");
+    Storage threaded("DoublePendulum3D_unlisted_threads4_UnlistedCoordinates_q.sto");
+    checkSameAsSerial(serial, threaded);
+}
+
+void checkSameAsSerial(const Storage& serial, const Storage& threaded)
+{
+    ASSERT(serial.getSize() > 1, __FILE__, __LINE__,
+        "Serial analysis recorded too few rows");
+    ASSERT(serial.getSize() == threaded.getSize(), __FILE__, __LINE__,
+        "Threaded analysis has a different number of rows");
+    ASSERT(serial.getColumnLabels() == threaded.getColumnLabels(),
+        __FILE__, __LINE__, "Threaded analysis has different columns");
+    for(int i=0; i<serial.getSize(); ++i){
+        const Array<double>& expected = serial.getStateVector(i)->getData();
+        const Array<double>& found = threaded.getStateVector(i)->getData();
+        ASSERT(serial.getStateVector(i)->getTime() ==
+               threaded.getStateVector(i)->getTime(), __FILE__, __LINE__,
+            "Threaded analysis times differ");
+        for(int j=0; j<expected.getSize(); ++j)
+            ASSERT(expected[j] == found[j], __FILE__, __LINE__,
+                "Threaded analysis differs from serial");
+    }
+}
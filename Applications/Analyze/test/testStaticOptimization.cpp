@@ -25,6 +25,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Analyses/StaticOptimizationTarget.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -37,6 +38,7 @@ using namespace std;
         Millard2012AccelerationMuscle
 */
 void testArm26(const string& muscleModelClassName, double atol, double ftol);
+void testQuadraticProgram();
 
 int main()
 {
@@ -53,6 +55,12 @@ int main()
     double forceTols[4] = {0.5, 4, 5, 6};
 
     SimTK::Array_<std::string> failures;
+
+    try { testQuadraticProgram(); }
+    catch (const std::exception& e) {
+        cout << e.what() <<endl; 
+        failures.push_back("testQuadraticProgram");
+    }
     
     for(int i=0; i< muscleModelNames.getSize(); ++i){
         try { // regression test for the Thelen deprecate muscle
@@ -125,6 +133,28 @@ void testArm26(const string& muscleModelClassName, double actTol, double forceTo
                                     __FILE__, __LINE__, 
                                     "Arm26 forces "+muscName+" failed.");
     cout << resultsDir <<": test Arm26 passed." << endl;
+
+    // Frames solved in blocks on several threads must match the standard too
+    AnalyzeTool analyzeThreads("arm26_Setup_StaticOptimization.xml");
+    analyzeThreads.setResultsDir(resultsDir+"_threads");
+    analyzeThreads.setNumThreads(4);
+    analyzeThreads.run();
+
+    Storage activationsThreads(
+        resultsDir+"_threads/arm26_StaticOptimization_activation.sto");
+    Storage forcesThreads(resultsDir+"_threads/arm26_StaticOptimization_force.sto");
+    ASSERT(activationsThreads.getSize() == activations1.getSize());
+
+    CHECK_STORAGE_AGAINST_STANDARD(activationsThreads, stdActivations1,
+                                    Array<double>(actTol, 6),
+                                    __FILE__, __LINE__,
+                                    "Arm26 activations on threads "+muscName+" failed");
+
+    CHECK_STORAGE_AGAINST_STANDARD(forcesThreads, stdForces1,
+                                    Array<double>(forceTol, 6),
+                                    __FILE__, __LINE__,
+                                    "Arm26 forces on threads "+muscName+" failed.");
+    cout << resultsDir <<": test Arm26 on threads passed." << endl;
   
     
     cout << "=============================================================\n" << endl;
@@ -156,4 +186,93 @@ void testArm26(const string& muscleModelClassName, double actTol, double forceTo
  
     cout << resultsDir << ": testArm26 with bounds passed" << endl;
     cout << "=============================================================\n" << endl;
-}
\ No newline at end of file
+}
+
+static SimTK::Vector vector3(double x1, double x2, double x3)
+{
+    SimTK::Vector v(3);
+    v[0] = x1; v[1] = x2; v[2] = x3;
+    return v;
+}
+
+/** Minimize x^T x subject to C x + d = 0 within bounds and require the known
+    solution, or failure. */
+static void checkQuadraticProgram(const SimTK::Matrix& C, const SimTK::Vector& d,
+    const SimTK::Vector& lower, const SimTK::Vector& upper,
+    Array<int>& activeBounds, const SimTK::Vector& expected, int maxIterations=100)
+{
+    SimTK::Vector x(C.ncol(), -1.0);
+    bool found = StaticOptimizationTarget::solveQuadraticProgram(C, d,
+        lower, upper, maxIterations, activeBounds, x);
+    if(expected.size()==0) {
+        ASSERT(!found, __FILE__, __LINE__,
+            "solveQuadraticProgram found a solution to an infeasible problem.");
+        for(int i=0; i<x.size(); i++)
+            ASSERT(x[i]==-1.0, __FILE__, __LINE__,
+                "solveQuadraticProgram changed x without a solution.");
+        return;
+    }
+    ASSERT(found, __FILE__, __LINE__,
+        "solveQuadraticProgram did not find a solution.");
+    for(int i=0; i<x.size(); i++)
+        ASSERT_EQUAL(expected[i], x[i], 1e-10, __FILE__, __LINE__,
+            "solveQuadraticProgram found the wrong solution.");
+}
+
+void testQuadraticProgram()
+{
+    SimTK::Vector lower(3, 0.0), upper(3, 10.0);
+    Array<int> activeBounds;
+
+    // x1 + x2 + x3 = 3: no bound is active.
+    SimTK::Matrix C(1, 3, 1.0);
+    SimTK::Vector d(1, -3.0);
+    checkQuadraticProgram(C, d, lower, upper, activeBounds,
+        SimTK::Vector(3, 1.0));
+
+    // Starting with x1 held at its lower bound, the bound is released.
+    activeBounds.setSize(3);
+    activeBounds[0] = -1; activeBounds[1] = 0; activeBounds[2] = 0;
+    checkQuadraticProgram(C, d, lower, upper, activeBounds,
+        SimTK::Vector(3, 1.0));
+
+    // x1 <= 0.5 is active, which takes two active sets.
+    SimTK::Vector upper1 = upper;
+    upper1[0] = 0.5;
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C, d, lower, upper1, activeBounds,
+        vector3(0.5, 1.25, 1.25));
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C, d, lower, upper1, activeBounds,
+        SimTK::Vector(), 1);
+
+    // x1 - x2 = 2: x2 >= 0 is active.
+    C(0,1) = -1.0; C(0,2) = 0.0;
+    d[0] = -2.0;
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C, d, lower, upper, activeBounds,
+        vector3(2.0, 0.0, 0.0));
+
+    // x1 + x2 = 2 and x2 + x3 = 2 give (2/3, 4/3, 2/3), and (1, 1, 1) with
+    // x2 <= 1.
+    SimTK::Matrix C2(2, 3, 0.0);
+    C2(0,0) = C2(0,1) = C2(1,1) = C2(1,2) = 1.0;
+    SimTK::Vector d2(2, -2.0);
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C2, d2, lower, upper, activeBounds,
+        vector3(2.0/3, 4.0/3, 2.0/3));
+    SimTK::Vector upper2 = upper;
+    upper2[1] = 1.0;
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C2, d2, lower, upper2, activeBounds,
+        SimTK::Vector(3, 1.0));
+
+    // x1 + x2 + x3 = 3 cannot be met with every x <= 0.5.
+    SimTK::Matrix C3(1, 3, 1.0);
+    SimTK::Vector d3(1, -3.0);
+    activeBounds.setSize(0);
+    checkQuadraticProgram(C3, d3, lower, SimTK::Vector(3, 0.5), activeBounds,
+        SimTK::Vector());
+
+    cout << "testQuadraticProgram passed" << endl;
+}
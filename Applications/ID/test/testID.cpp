@@ -33,6 +33,8 @@
 using namespace OpenSim;
 using namespace std;
 
+void testGaitThreaded();
+
 int main()
 {
     try {
@@ -47,6 +49,9 @@ int main()
         Storage result2("Results/subject01_InverseDynamics.sto"), standard2("std_subject01_InverseDynamics.sto");
         CHECK_STORAGE_AGAINST_STANDARD(result2, standard2, Array<double>(2.0, 23), __FILE__, __LINE__, "testGait failed");
         cout << "testGait passed" << endl;
+
+        testGaitThreaded();
+        cout << "testGaitThreaded passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -55,3 +60,34 @@ int main()
     cout << "Done" << endl;
     return 0;
 }
+
+void testGaitThreaded()
+{
+    // Solve the frames, which include external loads, serially and then on
+    // four threads, and require identical generalized forces.
+    int numThreads[2] = {1, 4};
+    for(int k=0; k<2; ++k){
+        InverseDynamicsTool id("subject01_Setup_InverseDynamics.xml");
+        id.setNumThreads(numThreads[k]);
+        id.setOutputGenForceFileName(
+            "subject01_InverseDynamics_threads" + to_string(numThreads[k]));
+        id.run();
+    }
+
+    Storage serial("Results/subject01_InverseDynamics_threads1.sto");
+    Storage threaded("Results/subject01_InverseDynamics_threads4.sto");
+    ASSERT(serial.getSize() == threaded.getSize(), __FILE__, __LINE__,
+        "Threaded inverse dynamics has a different number of rows");
+    ASSERT(serial.getColumnLabels() == threaded.getColumnLabels(),
+        __FILE__, __LINE__, "Threaded inverse dynamics has different columns");
+    for(int i=0; i<serial.getSize(); ++i){
+        const Array<double>& expected = serial.getStateVector(i)->getData();
+        const Array<double>& found = threaded.getStateVector(i)->getData();
+        ASSERT(serial.getStateVector(i)->getTime() ==
+               threaded.getStateVector(i)->getTime(), __FILE__, __LINE__,
+            "Threaded inverse dynamics times differ");
+        for(int j=0; j<expected.getSize(); ++j)
+            ASSERT(expected[j] == found[j], __FILE__, __LINE__,
+                "Threaded inverse dynamics differs from serial");
+    }
+}
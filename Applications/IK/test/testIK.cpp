@@ -50,6 +50,15 @@ int main()
         Storage result2(ik2.getOutputMotionFileName());
         CHECK_STORAGE_AGAINST_STANDARD(result2, standard, Array<double>(0.2, 24), __FILE__, __LINE__, "testInverseKinematicsGait2354 GUI workflow failed");
         cout << "testInverseKinematicsGait2354 GUI workflow passed" << endl;
+
+        InverseKinematicsTool ikChunked("subject01_Setup_InverseKinematics.xml");
+        ikChunked.setNumThreads(4);
+        ikChunked.setChunkOverlap(5);
+        ikChunked.setOutputMotionFileName("subject01_walk1_ik_chunked.mot");
+        ikChunked.run();
+        Storage resultChunked(ikChunked.getOutputMotionFileName());
+        CHECK_STORAGE_AGAINST_STANDARD(resultChunked, standard, Array<double>(0.2, 24), __FILE__, __LINE__, "testInverseKinematicsGait2354 in chunks failed");
+        cout << "testInverseKinematicsGait2354 in chunks passed" << endl;
         /*
         InverseKinematicsTool ik3("subjectOld_Setup_InverseKinematics.xml");
         ik3.run();
@@ -79,13 +79,26 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_table_tolerance();
 }
 
 void ActiveForceLengthCurve::buildCurve()
 {
-    SimTK::Function* f = createSimTKFunction();
-    m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
-    delete f;
+    double tableTolerance = getTableTolerance();
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+        "createFiberActiveForceLengthCurve",
+        {get_min_norm_active_fiber_length(),
+         get_transition_norm_fiber_length(),
+         get_max_norm_active_fiber_length(),
+         get_minimum_value(),
+         get_shallow_ascending_slope(),
+         tableTolerance},
+        [this, tableTolerance]() {
+            SmoothSegmentedFunction* curve = 
+                static_cast<SmoothSegmentedFunction*>(createSimTKFunction());
+            if(tableTolerance > 0)
+                curve->buildTable(tableTolerance);
+            return curve; });
     setObjectIsUpToDateWithProperties();
 }
 
@@ -147,6 +160,21 @@ void ActiveForceLengthCurve::setMinValue(double minimumValue)
     ensureCurveUpToDate();
 }
 
+double ActiveForceLengthCurve::getTableTolerance() const
+{
+    return getProperty_table_tolerance().size() > 0 ?
+        get_table_tolerance() : 0.0;
+}
+
+void ActiveForceLengthCurve::setTableTolerance(double tolerance)
+{
+    if(tolerance > 0)
+        set_table_tolerance(tolerance);
+    else
+        updProperty_table_tolerance().clear();
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -154,7 +182,7 @@ double ActiveForceLengthCurve::calcValue(double normFiberLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberLength);
+    return m_curve->calcValue(normFiberLength);
 }
 
 double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
@@ -166,7 +194,7 @@ double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
         "ActiveForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberLength,order);
+    return m_curve->calcDerivative(normFiberLength,order);
 }
 
 SimTK::Vec2 ActiveForceLengthCurve::getCurveDomain() const
@@ -174,7 +202,7 @@ SimTK::Vec2 ActiveForceLengthCurve::getCurveDomain() const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
 
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void ActiveForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -184,5 +212,9 @@ void ActiveForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     double xmin = min(0.0, get_min_norm_active_fiber_length());
     double xmax = max(2.0, get_max_norm_active_fiber_length());
 
-    m_curve.printMuscleCurveToCSVFile(path,xmin,xmax);
+    // The shared curve may have been built under another name.
+    SmoothSegmentedFunction curve(*m_curve);
+    std::string name = getName();
+    curve.setName(name);
+    curve.printMuscleCurveToCSVFile(path,xmin,xmax);
 }
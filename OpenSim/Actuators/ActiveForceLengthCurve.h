@@ -129,6 +129,8 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(table_tolerance, double,
+        "Relative accuracy of a table used to evaluate the curve faster; the curve is evaluated exactly if this is not given");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -201,6 +203,20 @@ public:
     */
     void setMinValue(double minimumValue);
 
+    /** Evaluates the curve from a table built to the given relative
+    accuracy, which is faster than evaluating its Bezier sections (see
+    SmoothSegmentedFunction::buildTable()). The curve is evaluated exactly by
+    default, and a tolerance of 0 restores exact evaluation.
+
+    @param tolerance
+        The relative accuracy of the table, or 0.
+    */
+    void setTableTolerance(double tolerance);
+
+    /** @returns The relative accuracy of the table the curve is evaluated
+    from, or 0 if the curve is evaluated exactly. */
+    double getTableTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -283,7 +299,9 @@ private:
     // Curve construction costs ~20,500 flops.
     void buildCurve();
 
-    SmoothSegmentedFunction   m_curve;
+    // The curve, which is shared with every other curve object that has the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve).
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
 };
 
 }
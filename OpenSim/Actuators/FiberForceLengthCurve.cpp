@@ -76,22 +76,34 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_table_tolerance();
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
 {
-    SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
-        createFiberForceLengthCurve(
-            get_strain_at_zero_force(),
-            get_strain_at_one_norm_force(),
-            m_stiffnessAtLowForceInUse,
-            m_stiffnessAtOneNormForceInUse,
-            m_curvinessInUse,
-            computeIntegral,
-            getName());
-
-    m_curve = *f;
-    delete f;
+    double tableTolerance = getTableTolerance();
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+        "createFiberForceLengthCurve",
+        {get_strain_at_zero_force(),
+         get_strain_at_one_norm_force(),
+         m_stiffnessAtLowForceInUse,
+         m_stiffnessAtOneNormForceInUse,
+         m_curvinessInUse,
+         computeIntegral ? 1.0 : 0.0,
+         tableTolerance},
+        [this, computeIntegral, tableTolerance]() {
+            SmoothSegmentedFunction* curve = SmoothSegmentedFunctionFactory::
+                createFiberForceLengthCurve(
+                    get_strain_at_zero_force(),
+                    get_strain_at_one_norm_force(),
+                    m_stiffnessAtLowForceInUse,
+                    m_stiffnessAtOneNormForceInUse,
+                    m_curvinessInUse,
+                    computeIntegral,
+                    getName());
+            if(tableTolerance > 0)
+                curve->buildTable(tableTolerance);
+            return curve; });
 
     setObjectIsUpToDateWithProperties();
 }
@@ -208,6 +220,21 @@ void FiberForceLengthCurve::setOptionalProperties(double aStiffnessAtLowForce,
     ensureCurveUpToDate();
 }
 
+double FiberForceLengthCurve::getTableTolerance() const
+{
+    return getProperty_table_tolerance().size() > 0 ?
+        get_table_tolerance() : 0.0;
+}
+
+void FiberForceLengthCurve::setTableTolerance(double tolerance)
+{
+    if(tolerance > 0)
+        set_table_tolerance(tolerance);
+    else
+        updProperty_table_tolerance().clear();
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -215,7 +242,7 @@ double FiberForceLengthCurve::calcValue(double normFiberLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberLength);
+    return m_curve->calcValue(normFiberLength);
 }
 
 double FiberForceLengthCurve::calcDerivative(double normFiberLength,
@@ -227,7 +254,7 @@ double FiberForceLengthCurve::calcDerivative(double normFiberLength,
         "FiberForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberLength,order);
+    return m_curve->calcDerivative(normFiberLength,order);
 }
 
 double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
@@ -235,20 +262,20 @@ double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
 
-    if(!m_curve.isIntegralAvailable()) {
+    if(!m_curve->isIntegralAvailable()) {
         FiberForceLengthCurve* mutableThis =
             const_cast<FiberForceLengthCurve*>(this);
         mutableThis->buildCurve(true);
     }
 
-    return m_curve.calcIntegral(normFiberLength);
+    return m_curve->calcIntegral(normFiberLength);
 }
 
 SimTK::Vec2 FiberForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void FiberForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -259,7 +286,11 @@ void FiberForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     xmin = xmin*0.9;
     double xmax = 1.0 + get_strain_at_one_norm_force()*1.1;
 
-    m_curve.printMuscleCurveToCSVFile(path, xmin, xmax);
+    // The shared curve may have been built under another name.
+    SmoothSegmentedFunction curve(*m_curve);
+    std::string name = getName();
+    curve.setName(name);
+    curve.printMuscleCurveToCSVFile(path, xmin, xmax);
 }
 
 //==============================================================================
@@ -174,6 +174,8 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(table_tolerance, double,
+        "Relative accuracy of a table used to evaluate the curve faster; the curve is evaluated exactly if this is not given");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -271,6 +273,20 @@ public:
                                double stiffnessAtOneNormForce,
                                double curviness);
 
+    /** Evaluates the curve from a table built to the given relative
+    accuracy, which is faster than evaluating its Bezier sections (see
+    SmoothSegmentedFunction::buildTable()). The curve is evaluated exactly by
+    default, and a tolerance of 0 restores exact evaluation.
+
+    @param tolerance
+        The relative accuracy of the table, or 0.
+    */
+    void setTableTolerance(double tolerance);
+
+    /** @returns The relative accuracy of the table the curve is evaluated
+    from, or 0 if the curve is evaluated exactly. */
+    double getTableTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -381,7 +397,9 @@ private:
     double calcCurvinessOfBestFit(double e0, double e1, double k0, double k1,
                                   double area, double relTol);
 
-    SmoothSegmentedFunction m_curve;
+    // The curve, which is shared with every other curve object that has the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve).
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
     double m_stiffnessAtLowForceInUse;
     double m_stiffnessAtOneNormForceInUse;
     double m_curvinessInUse;
@@ -81,13 +81,29 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_table_tolerance();
 }
 
 void ForceVelocityCurve::buildCurve()
 {
-    SimTK::Function* f = createSimTKFunction();
-    m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
-    delete f;
+    double tableTolerance = getTableTolerance();
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+        "createFiberForceVelocityCurve",
+        {get_max_eccentric_velocity_force_multiplier(),
+         get_concentric_slope_at_vmax(),
+         get_concentric_slope_near_vmax(),
+         get_isometric_slope(),
+         get_eccentric_slope_at_vmax(),
+         get_eccentric_slope_near_vmax(),
+         get_concentric_curviness(),
+         get_eccentric_curviness(),
+         tableTolerance},
+        [this, tableTolerance]() {
+            SmoothSegmentedFunction* curve = 
+                static_cast<SmoothSegmentedFunction*>(createSimTKFunction());
+            if(tableTolerance > 0)
+                curve->buildTable(tableTolerance);
+            return curve; });
     setObjectIsUpToDateWithProperties();
 }
 
@@ -165,6 +181,21 @@ void ForceVelocityCurve::setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+double ForceVelocityCurve::getTableTolerance() const
+{
+    return getProperty_table_tolerance().size() > 0 ?
+        get_table_tolerance() : 0.0;
+}
+
+void ForceVelocityCurve::setTableTolerance(double tolerance)
+{
+    if(tolerance > 0)
+        set_table_tolerance(tolerance);
+    else
+        updProperty_table_tolerance().clear();
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -172,7 +203,7 @@ double ForceVelocityCurve::calcValue(double normFiberVelocity) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ForceVelocityCurve: Curve is not up-to-date with its properties");
-    return m_curve.calcValue(normFiberVelocity);
+    return m_curve->calcValue(normFiberVelocity);
 }
 
 double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
@@ -184,18 +215,22 @@ double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
         "ForceVelocityCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(normFiberVelocity,order);
+    return m_curve->calcDerivative(normFiberVelocity,order);
 }
 
 SimTK::Vec2 ForceVelocityCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "ForceVelocityCurve: Curve is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void ForceVelocityCurve::printMuscleCurveToCSVFile(const std::string& path)
 {
     ensureCurveUpToDate();
-    m_curve.printMuscleCurveToCSVFile(path, -1.25, 1.25);
+    // The shared curve may have been built under another name.
+    SmoothSegmentedFunction curve(*m_curve);
+    std::string name = getName();
+    curve.setName(name);
+    curve.printMuscleCurveToCSVFile(path, -1.25, 1.25);
 }
@@ -160,6 +160,8 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(table_tolerance, double,
+        "Relative accuracy of a table used to evaluate the curve faster; the curve is evaluated exactly if this is not given");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -297,6 +299,20 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    /** Evaluates the curve from a table built to the given relative
+    accuracy, which is faster than evaluating its Bezier sections (see
+    SmoothSegmentedFunction::buildTable()). The curve is evaluated exactly by
+    default, and a tolerance of 0 restores exact evaluation.
+
+    @param tolerance
+        The relative accuracy of the table, or 0.
+    */
+    void setTableTolerance(double tolerance);
+
+    /** @returns The relative accuracy of the table the curve is evaluated
+    from, or 0 if the curve is evaluated exactly. */
+    double getTableTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -376,7 +392,9 @@ private:
     // curve.
     void buildCurve();
 
-    SmoothSegmentedFunction m_curve;
+    // The curve, which is shared with every other curve object that has the
+    // same parameters (see SmoothSegmentedFunctionFactory::getSharedCurve).
+    std::shared_ptr<const SmoothSegmentedFunction> m_curve;
 };
 
 }
@@ -82,6 +82,7 @@ void ForceVelocityInverseCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_table_tolerance();
 }
 
 void ForceVelocityInverseCurve::buildCurve()
@@ -89,6 +90,8 @@ void ForceVelocityInverseCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if(getTableTolerance() > 0)
+        m_curve.buildTable(getTableTolerance());
     setObjectIsUpToDateWithProperties();
 }
 
@@ -167,6 +170,21 @@ setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+double ForceVelocityInverseCurve::getTableTolerance() const
+{
+    return getProperty_table_tolerance().size() > 0 ?
+        get_table_tolerance() : 0.0;
+}
+
+void ForceVelocityInverseCurve::setTableTolerance(double tolerance)
+{
+    if(tolerance > 0)
+        set_table_tolerance(tolerance);
+    else
+        updProperty_table_tolerance().clear();
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
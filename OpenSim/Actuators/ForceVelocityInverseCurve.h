@@ -128,6 +128,8 @@ public:
         "Shape of concentric branch of force-velocity curve, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Shape of eccentric branch of force-velocity curve, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(table_tolerance, double,
+        "Relative accuracy of a table used to evaluate the curve faster; the curve is evaluated exactly if this is not given");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -265,6 +267,20 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    /** Evaluates the curve from a table built to the given relative
+    accuracy, which is faster than evaluating its Bezier sections (see
+    SmoothSegmentedFunction::buildTable()). The curve is evaluated exactly by
+    default, and a tolerance of 0 restores exact evaluation.
+
+    @param tolerance
+        The relative accuracy of the table, or 0.
+    */
+    void setTableTolerance(double tolerance);
+
+    /** @returns The relative accuracy of the table the curve is evaluated
+    from, or 0 if the curve is evaluated exactly. */
+    double getTableTolerance() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -409,6 +409,11 @@ computeInitialFiberEquilibrium(SimTK::State& s) const
         double clampedActivation = clampActivation(getActivation(s));
         setActivation(s,clampedActivation);
 
+        // The fiber length in the state, which is usually the last solution,
+        // is where the search for the new one begins.
+        double previousFiberLength =
+            getStateVariableValue(s, STATE_FIBER_LENGTH_NAME);
+
         // Initialize the multibody system to the initial state vector.
         setFiberLength(s, getOptimalFiberLength());
         _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity);
@@ -434,7 +439,14 @@ computeInitialFiberEquilibrium(SimTK::State& s) const
 
         SimTK::Vector soln;
         soln = estimateMuscleFiberState(clampedActivation, pathLength,
-                                        pathLengtheningSpeed, tol, maxIter);
+                                        pathLengtheningSpeed, tol, maxIter,
+                                        false, previousFiberLength);
+        if((int)soln[0] != 0) {
+            // Start over from a slightly stretched tendon.
+            soln = estimateMuscleFiberState(clampedActivation, pathLength,
+                                            pathLengtheningSpeed, tol,
+                                            maxIter);
+        }
         flag_status   = (int)soln[0];
         solnErr       = soln[1];
         iterations    = (int)soln[2];
@@ -543,11 +555,19 @@ computeFiberEquilibriumAtZeroVelocity(SimTK::State& s) const
         double pathLengtheningSpeed = 0.0;
 
         double activation = getActivation(s);
+        double previousFiberLength =
+            getStateVariableValue(s, STATE_FIBER_LENGTH_NAME);
 
         SimTK::Vector soln;
         soln = estimateMuscleFiberState(activation, pathLength,
                                         pathLengtheningSpeed, tol, maxIter,
-                                        true);
+                                        true, previousFiberLength);
+        if((int)soln[0] != 0) {
+            // Start over from a slightly stretched tendon.
+            soln = estimateMuscleFiberState(activation, pathLength,
+                                            pathLengtheningSpeed, tol,
+                                            maxIter, true);
+        }
         flag_status   = (int)soln[0];
         solnErr       = soln[1];
         iterations    = (int)soln[2];
@@ -1395,7 +1415,8 @@ estimateMuscleFiberState(double aActivation,
                          double pathLengtheningSpeed,
                          double aSolTolerance,
                          int aMaxIterations,
-                         bool staticSolution) const
+                         bool staticSolution,
+                         double initialFiberLength) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1435,11 +1456,20 @@ estimateMuscleFiberState(double aActivation,
     double fv  = 0.0;  // normalized force-velocity multiplier
     double fpe = 0.0;  // normalized parallel element force
 
-    // Position level
+    // Position level. Begin at the initial fiber length if it leaves the
+    // tendon some length, and otherwise with a small tendon force.
     double lce = 0.0;
-    double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-
-    lce = clampFiberLength(penMdl.calcFiberLength(ml,tl));
+    double tl  = 0.0;
+    if(SimTK::isFinite(initialFiberLength)
+        && initialFiberLength > getMinimumFiberLength()) {
+        lce = initialFiberLength;
+        tl  = penMdl.calcTendonLength(cos(penMdl.calcPennationAngle(lce)),
+                                      lce, ml);
+    }
+    if(!(tl > 0)) {
+        tl  = getTendonSlackLength()*1.01;
+        lce = clampFiberLength(penMdl.calcFiberLength(ml,tl));
+    }
 
     double phi    = penMdl.calcPennationAngle(lce);
     double cosphi = cos(phi);
@@ -1476,6 +1506,15 @@ estimateMuscleFiberState(double aActivation,
     double delta_lce    = 0.0;   // change in lce
     double Ke           = 0.0;   // linearized local stiffness of the muscle
 
+    // The last fiber lengths at which the error was negative and positive.
+    // In a static solution the error depends on the fiber length alone, so
+    // once both are known they bracket a solution, and a Newton step that
+    // leaves the bracket is replaced by bisection. Otherwise the velocities
+    // at each iterate are shared using the stiffnesses of the one before, so
+    // the error is not a function of the fiber length and is not bracketed.
+    double lceNegErr    = SimTK::NaN;
+    double lcePosErr    = SimTK::NaN;
+
     // Initialize the loop
     int iter = 0;
     int minFiberLengthCtr = 0;
@@ -1498,6 +1537,9 @@ estimateMuscleFiberState(double aActivation,
         FmAT = Fm * cosphi;
         Ft   = fse*fiso;
         ferr = FmAT - Ft;
+        if(staticSolution) {
+            if(ferr < 0) { lceNegErr = lce; } else { lcePosErr = lce; }
+        }
 
         // Compute the partial derivative of the force error w.r.t. lce
         dFm_dlce     = calcFiberStiffness(fiso,ma,fv,lceN,ofl);
@@ -1517,6 +1559,11 @@ estimateMuscleFiberState(double aActivation,
                 // Take a full Newton Step if the derivative is nonzero
                 delta_lce = -ferr/dferr_d_lce;
                 lce       = lce + delta_lce;
+
+                if(!SimTK::isNaN(lceNegErr) && !SimTK::isNaN(lcePosErr)
+                    && (lce-lceNegErr)*(lce-lcePosErr) >= 0) {
+                    lce = 0.5*(lceNegErr + lcePosErr);
+                }
             } else {
                 // We've stagnated; perturb the current solution
                 double perturbation =
@@ -710,13 +710,19 @@ private:
         @param aMaxIterations the maximum number of Newton steps allowed before
     we give up attempting to initialize the model and throw an exception
         @param staticSolution set to true to calculate the static equilibrium
-    solution, setting fiber and tendon velocities to zero */
+    solution, setting fiber and tendon velocities to zero; only a static
+    solution, or one at zero pathLengtheningSpeed, is kept bracketed
+        @param initialFiberLength the fiber length at which to begin, such as
+    the last solution; if NaN, the search begins with a slightly stretched
+    tendon */
     SimTK::Vector estimateMuscleFiberState(double aActivation,
                                            double pathLength,
                                            double pathLengtheningSpeed,
                                            double aSolTolerance,
                                            int aMaxIterations,
-                                           bool staticSolution=false) const;
+                                           bool staticSolution=false,
+                                           double initialFiberLength=
+                                               SimTK::NaN) const;
 
 };
 } //end of namespace OpenSim
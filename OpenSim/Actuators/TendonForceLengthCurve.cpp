@@ -88,19 +88,32 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_norm_force_at_toe_end();
     constructProperty_curviness();
+    constructProperty_table_tolerance();
 }
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
 {
-    SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
-        createTendonForceLengthCurve(get_strain_at_one_norm_force(),
-                                     m_stiffnessAtOneNormForceInUse,
-                                     m_normForceAtToeEndInUse,
-                                     m_curvinessInUse,
-                                     computeIntegral,
-                                     getName());
-    m_curve = *f;
-    delete f;
+    double tableTolerance = getTableTolerance();
+    m_curve = SmoothSegmentedFunctionFactory::getSharedCurve(
+        "createTendonForceLengthCurve",
+        {get_strain_at_one_norm_force(),
+         m_stiffnessAtOneNormForceInUse,
+         m_normForceAtToeEndInUse,
+         m_curvinessInUse,
+         computeIntegral ? 1.0 : 0.0,
+         tableTolerance},
+        [this, computeIntegral, tableTolerance]() {
+            SmoothSegmentedFunction* curve = SmoothSegmentedFunctionFactory::
+                createTendonForceLengthCurve(
+                    get_strain_at_one_norm_force(),
+                    m_stiffnessAtOneNormForceInUse,
+                    m_normForceAtToeEndInUse,
+                    m_curvinessInUse,
+                    computeIntegral,
+                    getName());
+            if(tableTolerance > 0)
+                curve->buildTable(tableTolerance);
+            return curve; });
     setObjectIsUpToDateWithProperties();
 }
 
@@ -213,6 +226,21 @@ SimTK::Function* TendonForceLengthCurve::createSimTKFunction() const
                 getName());
 }
 
+double TendonForceLengthCurve::getTableTolerance() const
+{
+    return getProperty_table_tolerance().size() > 0 ?
+        get_table_tolerance() : 0.0;
+}
+
+void TendonForceLengthCurve::setTableTolerance(double tolerance)
+{
+    if(tolerance > 0)
+        set_table_tolerance(tolerance);
+    else
+        updProperty_table_tolerance().clear();
+    ensureCurveUpToDate();
+}
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -220,7 +248,7 @@ double TendonForceLengthCurve::calcValue(double aNormLength) const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
-    return m_curve.calcValue(aNormLength);
+    return m_curve->calcValue(aNormLength);
 }
 
 double TendonForceLengthCurve::calcDerivative(double aNormLength,
@@ -232,7 +260,7 @@ double TendonForceLengthCurve::calcDerivative(double aNormLength,
         "TendonForceLengthCurve::calcDerivative",
         "order must be 0, 1, or 2, but %i was entered", order);
 
-    return m_curve.calcDerivative(aNormLength,order);
+    return m_curve->calcDerivative(aNormLength,order);
 }
 
 double TendonForceLengthCurve::calcIntegral(double aNormLength) const
@@ -240,20 +268,20 @@ double TendonForceLengthCurve::calcIntegral(double aNormLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
 
-    if (!m_curve.isIntegralAvailable()) {
+    if (!m_curve->isIntegralAvailable()) {
         TendonForceLengthCurve* mutableThis =
             const_cast<TendonForceLengthCurve*>(this);
         mutableThis->buildCurve(true);
     }
 
-    return m_curve.calcIntegral(aNormLength);
+    return m_curve->calcIntegral(aNormLength);
 }
 
 SimTK::Vec2 TendonForceLengthCurve::getCurveDomain() const
 {
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
-    return m_curve.getCurveDomain();
+    return m_curve->getCurveDomain();
 }
 
 void TendonForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
@@ -263,7 +291,11 @@ void TendonForceLengthCurve::printMuscleCurveToCSVFile(const std::string& path)
     double xmin = 0.9;
     double xmax = 1.0+get_strain_at_one_norm_force()*1.1;
 
-    m_curve.printMuscleCurveToCSVFile(path, xmin, xmax);
+    // The shared curve may have been built under another name.
+    SmoothSegmentedFunction curve(*m_curve);
+    std::string name = getName();
+    curve.setName(name);
+    curve.printMuscleCurveToCSVFile(path, xmin, xmax);
 }
 
 //==============================================================================
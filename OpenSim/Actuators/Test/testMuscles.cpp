@@ -103,6 +103,7 @@ void testThelen2003Muscle_Deprecated();
 void testThelen2003Muscle();
 void testMillard2012EquilibriumMuscle();
 void testMillard2012AccelerationMuscle();
+void testMillard2012MuscleEquilibrium();
 void testSchutte1993Muscle();
 void testDelp1990Muscle();
 
@@ -164,6 +165,12 @@ int main()
         e.print(cerr);
         failures.push_back("testMillard2012AccelerationMuscle");
     }
+    try { testMillard2012MuscleEquilibrium();
+        cout << "Millard2012MuscleEquilibrium Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cerr);
+        failures.push_back("testMillard2012MuscleEquilibrium");
+    }
 
     printf("\n\n");
     cout <<"************************************************************"<<endl;
@@ -922,6 +929,111 @@ void testMillard2012AccelerationMuscle()
         false);
 }
 
+/* A block on a slider pulled by Millard2012EquilibriumMuscles that take each
+of the branches of the model: damped and undamped elastic tendons, a rigid
+tendon, and no activation dynamics. */
+static void buildMillard2012MuscleBlock(Model& model)
+{
+    using SimTK::Vec3;
+    OpenSim::Body* block = new OpenSim::Body("block", 10, Vec3(0),
+                                  10*SimTK::Inertia::brick(0.05,0.05,0.05));
+    SliderJoint* slider = new SliderJoint("slider", model.updGround(),
+                              Vec3(0), Vec3(0), *block, Vec3(0), Vec3(0));
+    slider->upd_CoordinateSet()[0].setName("tx");
+    slider->upd_CoordinateSet()[0].setDefaultValue(
+        OptimalFiberLength0 + TendonSlackLength0);
+    model.addBody(block);
+    model.addJoint(slider);
+
+    for (int i = 0; i < 4; ++i) {
+        Millard2012EquilibriumMuscle* muscle =
+            new Millard2012EquilibriumMuscle("muscle" + std::to_string(i),
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle0);
+        if (i == 1) muscle->setFiberDamping(0.0);
+        if (i == 2) muscle->set_ignore_tendon_compliance(true);
+        if (i == 3) muscle->set_ignore_activation_dynamics(true);
+        muscle->addNewPathPoint("origin", model.updGround(), Vec3(0));
+        muscle->addNewPathPoint("insertion", *block, Vec3(0));
+        model.addForce(muscle);
+    }
+}
+
+void testMillard2012MuscleEquilibrium()
+{
+    Model model;
+    buildMillard2012MuscleBlock(model);
+    SimTK::State& s = model.initSystem();
+    const Coordinate& tx = model.getCoordinateSet()[0];
+    const double tol = 1e-6*MaxIsometricForce0;
+
+    // Equilibrate the muscles at a series of lengths, each solve beginning
+    // at the last solution, and then again from the default starting point.
+    for (int k = 0; k < 5; ++k) {
+        tx.setValue(s, OptimalFiberLength0 + TendonSlackLength0 + 0.01*k);
+        model.equilibrateMuscles(s);
+        model.realizeDynamics(s);
+
+        SimTK::Vector seeded(4);
+        for (int i = 0; i < 4; ++i) {
+            const Muscle& muscle = model.getMuscles()[i];
+            seeded[i] = muscle.getFiberLength(s);
+            ASSERT_EQUAL(muscle.getTendonForce(s),
+                muscle.getFiberForceAlongTendon(s), tol, __FILE__, __LINE__,
+                "Millard2012EquilibriumMuscle is not in equilibrium.");
+            if (!muscle.get_ignore_tendon_compliance())
+                dynamic_cast<const Millard2012EquilibriumMuscle&>(muscle)
+                    .setFiberLength(s, SimTK::NaN);
+        }
+
+        model.equilibrateMuscles(s);
+        model.realizeDynamics(s);
+        for (int i = 0; i < 4; ++i)
+            ASSERT_EQUAL(model.getMuscles()[i].getFiberLength(s), seeded[i],
+                1e-6*OptimalFiberLength0, __FILE__, __LINE__,
+                "Millard2012EquilibriumMuscle equilibrium depends on where "
+                "the solve began.");
+    }
+
+    // Fully activate the elastic tendon muscles and begin their solves at
+    // fiber lengths across the whole active range. From seeds on the
+    // descending limb, where the negative stiffness of the fiber nearly
+    // cancels the stiffness of the tendon, the Newton step overshoots the
+    // solution and the solve must bisect its bracket instead.
+    tx.setValue(s, OptimalFiberLength0 + TendonSlackLength0);
+    SimTK::Vector solution(2);
+    for (int i = 0; i < 2; ++i) {
+        const Millard2012EquilibriumMuscle& muscle =
+            dynamic_cast<const Millard2012EquilibriumMuscle&>(
+                model.getMuscles()[i]);
+        muscle.setActivation(s, 1.0);
+        muscle.setFiberLength(s, SimTK::NaN);
+    }
+    model.equilibrateMuscles(s);
+    model.realizeDynamics(s);
+    for (int i = 0; i < 2; ++i)
+        solution[i] = model.getMuscles()[i].getFiberLength(s);
+
+    for (double lceN = 0.5; lceN < 1.85; lceN += 0.05) {
+        for (int i = 0; i < 2; ++i)
+            dynamic_cast<const Millard2012EquilibriumMuscle&>(
+                model.getMuscles()[i]).setFiberLength(s,
+                    lceN*OptimalFiberLength0);
+        model.equilibrateMuscles(s);
+        model.realizeDynamics(s);
+        for (int i = 0; i < 2; ++i) {
+            const Muscle& muscle = model.getMuscles()[i];
+            ASSERT_EQUAL(muscle.getTendonForce(s),
+                muscle.getFiberForceAlongTendon(s), tol, __FILE__, __LINE__,
+                "Millard2012EquilibriumMuscle is not in equilibrium.");
+            ASSERT_EQUAL(muscle.getFiberLength(s), solution[i],
+                1e-6*OptimalFiberLength0, __FILE__, __LINE__,
+                "Millard2012EquilibriumMuscle equilibrium depends on where "
+                "the solve began.");
+        }
+    }
+}
+
 void testSchutte1993Muscle()
 {
     Schutte1993Muscle_Deprecated muscle("muscle",
@@ -45,6 +45,7 @@ void testTendonForceLengthCurve();
 void testFiberForceLengthCurve();
 void testFiberCompressiveForceLengthCurve();
 void testFiberCompressiveForceCosPennationCurve();
+void testSharedCurves();
 
 int main(int argc, char* argv[])
 {
@@ -59,6 +60,7 @@ int main(int argc, char* argv[])
             testFiberForceLengthCurve();
             testFiberCompressiveForceLengthCurve();
             testFiberCompressiveForceCosPennationCurve();
+            testSharedCurves();
 
             cout << "================================================" << endl;
             cout << "                   Timing Tests                 " << endl;
@@ -1227,3 +1229,59 @@ void testFiberCompressiveForceCosPennationCurve()
         cout <<"________________________________________________________"<<endl;
 
 }
+
+void testSharedCurves()
+{
+        cout <<"________________________________________________________"<<endl;
+        cout <<"8. Testing: Shared curves "<<endl;       
+        cout <<"________________________________________________________"<<endl;
+
+        // Curves with the same parameters share one SmoothSegmentedFunction,
+        // whatever their names.
+        ActiveForceLengthCurve fal1;
+        int numShared = SmoothSegmentedFunctionFactory::getNumSharedCurves();
+        ActiveForceLengthCurve fal2;
+        fal2.setName("fal2");
+        ActiveForceLengthCurve fal3(fal1);
+        SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() 
+                   == numShared);
+        SimTK_TEST(fal2.calcValue(0.8) == fal1.calcValue(0.8));
+
+        // Changing a parameter builds a curve of its own and leaves the
+        // others alone.
+        fal2.setMinValue(0.2);
+        SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() 
+                   == numShared+1);
+        SimTK_TEST(fal2.calcValue(0.8) != fal1.calcValue(0.8));
+        SimTK_TEST(fal3.calcValue(0.8) == fal1.calcValue(0.8));
+
+        // A curve with its integral is distinct from one without.
+        TendonForceLengthCurve fse1, fse2;
+        numShared = SmoothSegmentedFunctionFactory::getNumSharedCurves();
+        fse1.calcIntegral(1.02);
+        SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() 
+                   == numShared+1);
+        SimTK_TEST(fse2.calcIntegral(1.02) == fse1.calcIntegral(1.02));
+        SimTK_TEST(SmoothSegmentedFunctionFactory::getNumSharedCurves() 
+                   <= numShared+1);
+
+        // A tabulated curve stays within its tolerance of the exact one, and
+        // is still tabulated when copied.
+        ForceVelocityCurve fv1, fv2;
+        fv2.setTableTolerance(1e-6);
+        SimTK_TEST(fv1.getTableTolerance() == 0);
+        SimTK_TEST(fv2.getTableTolerance() == 1e-6);
+        for(double v = -0.95; v < 1.0; v += 0.05) {
+            SimTK_TEST_EQ_TOL(fv2.calcValue(v), fv1.calcValue(v), 1e-5);
+            SimTK_TEST_EQ_TOL(fv2.calcDerivative(v,1),
+                              fv1.calcDerivative(v,1), 1e-4);
+        }
+        ForceVelocityCurve fv3(fv2);
+        SimTK_TEST(fv3.calcValue(0.33) == fv2.calcValue(0.33));
+        ForceVelocityCurve fv4;
+        fv4.setTableTolerance(1e-6);
+        fv4.setTableTolerance(0);
+        SimTK_TEST(fv4.calcValue(0.33) == fv1.calcValue(0.33));
+
+        cout << "    passed" << endl;
+}
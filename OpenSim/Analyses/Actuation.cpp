@@ -290,6 +290,7 @@ deleteStorage()
     if (_forceStore != NULL) { delete _forceStore;  _forceStore = NULL; }
     if (_speedStore != NULL) { delete _speedStore;  _speedStore = NULL; }
     if (_powerStore != NULL) { delete _powerStore;  _powerStore = NULL; }
+    _storageList.setSize(0);
 }
 
 
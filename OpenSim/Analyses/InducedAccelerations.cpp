@@ -24,8 +24,12 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -75,6 +79,7 @@ InducedAccelerations::InducedAccelerations(Model *aModel) :
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
     _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _bodySet(*new BodySet()),
     _coordSet(*new CoordinateSet())
 {
@@ -103,6 +108,7 @@ InducedAccelerations::InducedAccelerations(const std::string &aFileName):
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
     _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _bodySet(*new BodySet()),
     _coordSet(*new CoordinateSet())
 {
@@ -127,6 +133,7 @@ InducedAccelerations::InducedAccelerations(const InducedAccelerations &aInducedA
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
     _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _bodySet(*new BodySet()),
     _coordSet(*new CoordinateSet())
 {
@@ -160,6 +167,7 @@ operator=(const InducedAccelerations &aInducedAccelerations)
     _forceThreshold = aInducedAccelerations._forceThreshold;
     _computePotentialsOnly = aInducedAccelerations._computePotentialsOnly;
     _reportConstraintReactions = aInducedAccelerations._reportConstraintReactions;
+    _numThreads = aInducedAccelerations._numThreads;
     _includeCOM = aInducedAccelerations._includeCOM;
     return(*this);
 }
@@ -179,6 +187,9 @@ void InducedAccelerations::setNull()
     _bodyNames[0] = CENTER_OF_MASS_NAME;
     _computePotentialsOnly = false;
     _reportConstraintReactions = false;
+    _numThreads = 1;
+    _analysisStateIsBuilt = false;
+    _hasPathForces = false;
     // Analysis does not own contents of these sets
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
@@ -221,6 +232,12 @@ void InducedAccelerations::setupProperties()
     _reportConstraintReactionsProp.setName("report_constraint_reactions");
     _reportConstraintReactionsProp.setComment("Report individual contributions to constraint reactions in addition to accelerations.");
     _propertySet.append(&_reportConstraintReactionsProp);
+
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setComment("Number of threads used to solve for the contributors other than the total "
+        "at each time. A value of 0 uses one thread per processor. Models with path forces "
+        "(e.g., muscles and ligaments) are always solved on one thread.");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -456,6 +473,7 @@ void InducedAccelerations::setupStorage()
     }
 
     delete _storeConstraintReactions;
+    _storeConstraintReactions = NULL;
     if(_reportConstraintReactions){
         Array<string> constReactionLabels = constructColumnLabelsForConstraintReactions();
         _constraintReactions.setSize(0);
@@ -464,6 +482,14 @@ void InducedAccelerations::setupStorage()
         _storeConstraintReactions->setColumnLabels(constReactionLabels);
     }
 
+    // LIST OF STORAGES
+    _storageList.setSize(0);
+    _storageList.setMemoryOwner(false);
+    for(int i=0; i<_storeInducedAccelerations.getSize(); i++)
+        _storageList.append(_storeInducedAccelerations[i]);
+    if(_storeConstraintReactions)
+        _storageList.append(_storeConstraintReactions);
+
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
 }
@@ -495,292 +521,382 @@ void InducedAccelerations::setModel(Model &aModel)
 //=============================================================================
 //_____________________________________________________________________________
 /**
- * Compute and record the results.
+ * Solve for the accelerations induced by one contributor.
  *
- * This method, for the purpose of example, records the position and
- * orientation of each body in the model.  You will need to customize it
- * to perform your analysis.
+ * Forces are turned on and off only through flags in s_analysis, so
+ * contributors other than "total" may be solved concurrently on separate
+ * copies of the analysis state.
  *
- * @param aT Current time in the simulation.
- * @param aX Current values of the controls.
- * @param aY Current values of the states: includes generalized coords and speeds
+ * @param s_analysis Analysis state, with the contact constraints set up.
+ * @param s State of the model being analyzed.
+ * @param c Index of the contributor.
+ * @param constraintOn Which contact constraints are on at this time.
+ * @param rAccs Induced coordinate, body and center of mass accelerations,
+ * followed by the constraint reactions when these are reported.
  */
-int InducedAccelerations::record(const SimTK::State& s)
+void InducedAccelerations::solveForContributor(SimTK::State& s_analysis,
+        const SimTK::State& s, int c, const Array<bool>& constraintOn,
+        Array<double>& rAccs)
 {
     int nu = _model->getNumSpeeds();
     double aT = s.getTime();
-    cout << "time = " << aT << endl;
+    const SimTK::Vector& Q = s.getQ();
+    rAccs.setSize(0);
 
-    SimTK::Vector Q = s.getQ();
+    //cout << "Solving for contributor: " << _contributors[c] << endl;
+    // Need to be at the dynamics stage to disable a force
+    _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
+    
+    if(_contributors[c] == "total"){
+        // Set gravity ON
+        _model->getGravityForce().enable(s_analysis);
+
+        //Use same conditions on constraints
+        s_analysis.setTime(aT);
+        // Set the configuration (gen. coords and speeds) of the model.
+        s_analysis.setQ(Q);
+        s_analysis.setU(s.getU());
+        s_analysis.setZ(s.getZ());
+
+        //Make sure all the actuators are on!
+        for(int f=0; f<_model->getActuators().getSize(); f++){
+            _model->getActuators().get(f).setDisabled(s_analysis, false);
+        }
 
-    // Reset Accelerations for coordinates at this time step
-    for(int i=0;i<_coordSet.getSize();i++) {
-        _coordIndAccs[i]->setSize(0);
-    }
+        // Get to  the point where we can evaluate unilateral constraint conditions
+         _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
 
-    // Reset Accelerations for bodies at this time step
-    for(int i=0;i<_bodySet.getSize();i++) {
-        _bodyIndAccs[i]->setSize(0);
-    }
+        /* *********************************** ERROR CHECKING *******************************
+        SimTK::Vec3 pcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterLocationInGround(s_analysis);
+        SimTK::Vec3 vcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterVelocityInGround(s_analysis);
+        SimTK::Vec3 acom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
 
-    // Reset Accelerations for system center of mass at this time step
-    _comIndAccs.setSize(0);
-    _constraintReactions.setSize(0);
+        SimTK::Matrix M;
+        _model->getMultibodySystem().getMatterSubsystem().calcM(s_analysis, M);
+        cout << "mass matrix: " << M << endl;
 
-    SimTK::State s_analysis = _model->getWorkingState();
-
-    _model->initStateWithoutRecreatingSystem(s_analysis);
-    // Just need to set current time and position to determine state of constraints
-    s_analysis.setTime(aT);
-    s_analysis.setQ(Q);
-
-    // Check the external forces and determine if contact constraints should be applied at this time
-    // and turn constraint on if it should be.
-    Array<bool> constraintOn = applyContactConstraintAccordingToExternalForces(s_analysis);
-
-    // Hang on to a state that has the right flags for contact constraints turned on/off
-    _model->setPropertiesFromState(s_analysis);
-    // Use this state for the remainder of this step (record)
-    s_analysis = _model->getMultibodySystem().realizeTopology();
-    // DO NOT recreate the system, will lose location of constraint
-    _model->initStateWithoutRecreatingSystem(s_analysis);
-
-    // Cycle through the force contributors to the system acceleration
-    for(int c=0; c< _contributors.getSize(); c++){          
-        //cout << "Solving for contributor: " << _contributors[c] << endl;
-        // Need to be at the dynamics stage to disable a force
-        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
-        
-        if(_contributors[c] == "total"){
-            // Set gravity ON
-            _model->getGravityForce().enable(s_analysis);
-
-            //Use same conditions on constraints
-            s_analysis.setTime(aT);
-            // Set the configuration (gen. coords and speeds) of the model.
-            s_analysis.setQ(Q);
-            s_analysis.setU(s.getU());
-            s_analysis.setZ(s.getZ());
-
-            //Make sure all the actuators are on!
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setDisabled(s_analysis, false);
-            }
+        SimTK::Inertia sysInertia = _model->getMultibodySystem().getMatterSubsystem().calcSystemCentralInertiaInGround(s_analysis);
+        cout << "system inertia: " << sysInertia << endl;
 
-            // Get to  the point where we can evaluate unilateral constraint conditions
-             _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+        SimTK::SpatialVec sysMomentum =_model->getMultibodySystem().getMatterSubsystem().calcSystemMomentumAboutGroundOrigin(s_analysis);
+        cout << "system momentum: " << sysMomentum << endl;
 
-            /* *********************************** ERROR CHECKING *******************************
-            SimTK::Vec3 pcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterLocationInGround(s_analysis);
-            SimTK::Vec3 vcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterVelocityInGround(s_analysis);
-            SimTK::Vec3 acom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
+        const SimTK::Vector &appliedMobilityForces = _model->getMultibodySystem().getMobilityForces(s_analysis, SimTK::Stage::Dynamics);
+        appliedMobilityForces.dump("All Applied Mobility Forces");
+    
+        // Get all applied body forces like those from conact
+        const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces = _model->getMultibodySystem().getRigidBodyForces(s_analysis, SimTK::Stage::Dynamics);
+        appliedBodyForces.dump("All Applied Body Forces");
+
+        SimTK::Vector ucUdot;
+        SimTK::Vector_<SimTK::SpatialVec> ucA_GB;
+        _model->getMultibodySystem().getMatterSubsystem().calcAccelerationIgnoringConstraints(s_analysis, appliedMobilityForces, appliedBodyForces, ucUdot, ucA_GB) ;
+        ucUdot.dump("Udots Ignoring Constraints");
+        ucA_GB.dump("Body Accelerations");
+
+        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize(), SimTK::SpatialVec(SimTK::Vec3(0)));
+        SimTK::Vector constraintMobilityForces(0);
+
+        int nc = _model->getMultibodySystem().getMatterSubsystem().getNumConstraints();
+        for (SimTK::ConstraintIndex cx(0); cx < nc; ++cx) {
+            if (!_model->getMultibodySystem().getMatterSubsystem().isConstraintDisabled(s_analysis, cx)){
+                cout << "Constraint " << cx << " enabled!" << endl;
+            }
+        }
+        //int nMults = _model->getMultibodySystem().getMatterSubsystem().getTotalMultAlloc();
 
-            SimTK::Matrix M;
-            _model->getMultibodySystem().getMatterSubsystem().calcM(s_analysis, M);
-            cout << "mass matrix: " << M << endl;
+        for(int i=0; i<constraintOn.getSize(); i++) {
+            if(constraintOn[i])
+                _constraintSet[i].calcConstraintForces(s_analysis, constraintBodyForces, constraintMobilityForces);
+        }
+        constraintBodyForces.dump("Constraint Body Forces");
+        constraintMobilityForces.dump("Constraint Mobility Forces");
+        // ******************************* end ERROR CHECKING *******************************/
 
-            SimTK::Inertia sysInertia = _model->getMultibodySystem().getMatterSubsystem().calcSystemCentralInertiaInGround(s_analysis);
-            cout << "system inertia: " << sysInertia << endl;
+        for(int i=0; i<constraintOn.getSize(); i++) {
+            _constraintSet.get(i).setDisabled(s_analysis, !constraintOn[i]);
+            // Make sure we stay at Dynamics so each constraint can evaluate its conditions
+            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+        }
 
-            SimTK::SpatialVec sysMomentum =_model->getMultibodySystem().getMatterSubsystem().calcSystemMomentumAboutGroundOrigin(s_analysis);
-            cout << "system momentum: " << sysMomentum << endl;
+        // This should also push changes to defaults for unilateral conditions
+        _model->setPropertiesFromState(s_analysis);
 
-            const SimTK::Vector &appliedMobilityForces = _model->getMultibodySystem().getMobilityForces(s_analysis, SimTK::Stage::Dynamics);
-            appliedMobilityForces.dump("All Applied Mobility Forces");
-        
-            // Get all applied body forces like those from conact
-            const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces = _model->getMultibodySystem().getRigidBodyForces(s_analysis, SimTK::Stage::Dynamics);
-            appliedBodyForces.dump("All Applied Body Forces");
-
-            SimTK::Vector ucUdot;
-            SimTK::Vector_<SimTK::SpatialVec> ucA_GB;
-            _model->getMultibodySystem().getMatterSubsystem().calcAccelerationIgnoringConstraints(s_analysis, appliedMobilityForces, appliedBodyForces, ucUdot, ucA_GB) ;
-            ucUdot.dump("Udots Ignoring Constraints");
-            ucA_GB.dump("Body Accelerations");
-
-            SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize(), SimTK::SpatialVec(SimTK::Vec3(0)));
-            SimTK::Vector constraintMobilityForces(0);
-
-            int nc = _model->getMultibodySystem().getMatterSubsystem().getNumConstraints();
-            for (SimTK::ConstraintIndex cx(0); cx < nc; ++cx) {
-                if (!_model->getMultibodySystem().getMatterSubsystem().isConstraintDisabled(s_analysis, cx)){
-                    cout << "Constraint " << cx << " enabled!" << endl;
-                }
-            }
-            //int nMults = _model->getMultibodySystem().getMatterSubsystem().getTotalMultAlloc();
+    }
+    else if(_contributors[c] == "gravity"){
+        // Set gravity ON
+        _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), false);
 
-            for(int i=0; i<constraintOn.getSize(); i++) {
-                if(constraintOn[i])
-                    _constraintSet[i].calcConstraintForces(s_analysis, constraintBodyForces, constraintMobilityForces);
-            }
-            constraintBodyForces.dump("Constraint Body Forces");
-            constraintMobilityForces.dump("Constraint Mobility Forces");
-            // ******************************* end ERROR CHECKING *******************************/
-    
-            for(int i=0; i<constraintOn.getSize(); i++) {
-                _constraintSet.get(i).setDisabled(s_analysis, !constraintOn[i]);
-                // Make sure we stay at Dynamics so each constraint can evaluate its conditions
-                _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
-            }
+        //s_analysis = _model->initSystem();
+        s_analysis.setTime(aT);
+        s_analysis.setQ(Q);
 
-            // This should also push changes to defaults for unilateral conditions
-            _model->setPropertiesFromState(s_analysis);
+        // zero velocity
+        s_analysis.setU(SimTK::Vector(nu,0.0));
+        s_analysis.setZ(s.getZ());
 
+        // disable actuator forces
+        for(int f=0; f<_model->getActuators().getSize(); f++){
+            _model->getActuators().get(f).setDisabled(s_analysis, true);
         }
-        else if(_contributors[c] == "gravity"){
-            // Set gravity ON
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), false);
+    }
+    else if(_contributors[c] == "velocity"){        
+        // Set gravity off
+        _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
 
-            //s_analysis = _model->initSystem();
-            s_analysis.setTime(aT);
-            s_analysis.setQ(Q);
+        s_analysis.setTime(aT);
+        s_analysis.setQ(Q);
 
-            // zero velocity
-            s_analysis.setU(SimTK::Vector(nu,0.0));
-            s_analysis.setZ(s.getZ());
+        // non-zero velocity
+        s_analysis.setU(s.getU());
+        s_analysis.setZ(s.getZ());
+        
+        // zero actuator forces
+        for(int f=0; f<_model->getActuators().getSize(); f++){
+            _model->getActuators().get(f).setDisabled(s_analysis, true);
+        }
+        // Set the configuration (gen. coords and speeds) of the model.
+        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
+    }
+    else{ //The rest are actuators      
+        // Set gravity OFF
+        _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
 
-            // disable actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setDisabled(s_analysis, true);
-            }
+        // zero actuator forces
+        for(int f=0; f<_model->getActuators().getSize(); f++){
+            _model->getActuators().get(f).setDisabled(s_analysis, true);
         }
-        else if(_contributors[c] == "velocity"){        
-            // Set gravity off
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
-
-            s_analysis.setTime(aT);
-            s_analysis.setQ(Q);
-
-            // non-zero velocity
-            s_analysis.setU(s.getU());
-            s_analysis.setZ(s.getZ());
-            
-            // zero actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setDisabled(s_analysis, true);
+
+        //s_analysis = _model->initSystem();
+        s_analysis.setTime(aT);
+        s_analysis.setQ(Q);
+
+        // zero velocity
+        SimTK::Vector U(nu,0.0);
+        s_analysis.setU(U);
+        s_analysis.setZ(s.getZ());
+        // light up the one actuator who's contribution we are looking for
+        int ai = _model->getActuators().getIndex(_contributors[c]);
+        if(ai<0)
+            throw Exception("InducedAcceleration: ERR- Could not find actuator '"+_contributors[c],__FILE__,__LINE__);
+        
+        const Actuator &actuator = _model->getActuators().get(ai);
+        const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuator);
+        act->setDisabled(s_analysis, false);
+        act->overrideActuation(s_analysis, false);
+        const Muscle *muscle = dynamic_cast<const Muscle *>(&actuator);
+        if(muscle){
+            if(_computePotentialsOnly){
+                muscle->overrideActuation(s_analysis, true);
+                muscle->setOverrideActuation(s_analysis, 1.0);
             }
-            // Set the configuration (gen. coords and speeds) of the model.
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
         }
-        else{ //The rest are actuators      
-            // Set gravity OFF
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
 
-            // zero actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setDisabled(s_analysis, true);
-            }
+        // Set the configuration (gen. coords and speeds) of the model.
+        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Model);
+        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
 
-            //s_analysis = _model->initSystem();
-            s_analysis.setTime(aT);
-            s_analysis.setQ(Q);
-
-            // zero velocity
-            SimTK::Vector U(nu,0.0);
-            s_analysis.setU(U);
-            s_analysis.setZ(s.getZ());
-            // light up the one actuator who's contribution we are looking for
-            int ai = _model->getActuators().getIndex(_contributors[c]);
-            if(ai<0)
-                throw Exception("InducedAcceleration: ERR- Could not find actuator '"+_contributors[c],__FILE__,__LINE__);
-            
-            Actuator &actuator = _model->getActuators().get(ai);
-            ScalarActuator* act = dynamic_cast<ScalarActuator*>(&actuator);
-            act->setDisabled(s_analysis, false);
-            act->overrideActuation(s_analysis, false);
-            Muscle *muscle = dynamic_cast<Muscle *>(&actuator);
-            if(muscle){
-                if(_computePotentialsOnly){
-                    muscle->overrideActuation(s_analysis, true);
-                    muscle->setOverrideActuation(s_analysis, 1.0);
-                }
-            }
+    }// End of if to select contributor 
 
-            // Set the configuration (gen. coords and speeds) of the model.
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Model);
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
+    // cout << "Constraint 0 is of "<< _constraintSet[0].getConcreteClassName() << " and should be " << constraintOn[0] << " and is actually " <<  (_constraintSet[0].isDisabled(s_analysis) ? "off" : "on") << endl;
+    // cout << "Constraint 1 is of "<< _constraintSet[1].getConcreteClassName() << " and should be " << constraintOn[1] << " and is actually " <<  (_constraintSet[1].isDisabled(s_analysis) ? "off" : "on") << endl;
 
-        }// End of if to select contributor 
+    // After setting the state of the model and applying forces
+    // Compute the derivative of the multibody system (speeds and accelerations)
+    _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
 
-        // cout << "Constraint 0 is of "<< _constraintSet[0].getConcreteClassName() << " and should be " << constraintOn[0] << " and is actually " <<  (_constraintSet[0].isDisabled(s_analysis) ? "off" : "on") << endl;
-        // cout << "Constraint 1 is of "<< _constraintSet[1].getConcreteClassName() << " and should be " << constraintOn[1] << " and is actually " <<  (_constraintSet[1].isDisabled(s_analysis) ? "off" : "on") << endl;
+    // Sanity check that constraints hasn't totally changed the configuration of the model
+    double error = (Q-s_analysis.getQ()).norm();
 
-        // After setting the state of the model and applying forces
-        // Compute the derivative of the multibody system (speeds and accelerations)
-        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+    // Report reaction forces for debugging
+    /*
+    SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize());
+    SimTK::Vector mobilityForces(0);
 
-        // Sanity check that constraints hasn't totally changed the configuration of the model
-        double error = (Q-s_analysis.getQ()).norm();
+    for(int i=0; i<constraintOn.getSize(); i++) {
+        if(constraintOn[i])
+            _constraintSet.get(i).calcConstraintForces(s_analysis, constraintBodyForces, mobilityForces);
+    }*/
 
-        // Report reaction forces for debugging
-        /*
-        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize());
-        SimTK::Vector mobilityForces(0);
+    // VARIABLES
+    SimTK::Vec3 vec,angVec;
 
-        for(int i=0; i<constraintOn.getSize(); i++) {
-            if(constraintOn[i])
-                _constraintSet.get(i).calcConstraintForces(s_analysis, constraintBodyForces, mobilityForces);
-        }*/
+    // Get Accelerations for kinematics of bodies
+    for(int i=0;i<_coordSet.getSize();i++) {
+        double acc = _coordSet.get(i).getAccelerationValue(s_analysis);
 
-        // VARIABLES
-        SimTK::Vec3 vec,angVec;
+        if(getInDegrees()) 
+            acc *= SimTK_RADIAN_TO_DEGREE;  
+        rAccs.append(acc);
+    }
 
-        // Get Accelerations for kinematics of bodies
-        for(int i=0;i<_coordSet.getSize();i++) {
-            double acc = _coordSet.get(i).getAccelerationValue(s_analysis);
+    // cout << "Input Body Names: "<< _bodyNames << endl;
 
-            if(getInDegrees()) 
-                acc *= SimTK_RADIAN_TO_DEGREE;  
-            _coordIndAccs[i]->append(1, &acc);
-        }
+    // Get Accelerations for kinematics of bodies
+    for(int i=0;i<_bodySet.getSize();i++) {
+        Body &body = _bodySet.get(i);
+        // cout << "Body Name: "<< body->getName() << endl;
+        const SimTK::Vec3& com = body.get_mass_center();
+        
+        // Get the body acceleration
+        _model->getSimbodyEngine().getAcceleration(s_analysis, body, com, vec);
+        _model->getSimbodyEngine().getAngularAcceleration(s_analysis, body, angVec);    
 
-        // cout << "Input Body Names: "<< _bodyNames << endl;
-
-        // Get Accelerations for kinematics of bodies
-        for(int i=0;i<_bodySet.getSize();i++) {
-            Body &body = _bodySet.get(i);
-            // cout << "Body Name: "<< body->getName() << endl;
-            const SimTK::Vec3& com = body.get_mass_center();
-            
-            // Get the body acceleration
-            _model->getSimbodyEngine().getAcceleration(s_analysis, body, com, vec);
-            _model->getSimbodyEngine().getAngularAcceleration(s_analysis, body, angVec);    
-
-            // CONVERT TO DEGREES?
-            if(getInDegrees()) 
-                angVec *= SimTK_RADIAN_TO_DEGREE;   
-
-            // FILL KINEMATICS ARRAY
-            _bodyIndAccs[i]->append(3, &vec[0]);
-            _bodyIndAccs[i]->append(3, &angVec[0]);
-        }
+        // CONVERT TO DEGREES?
+        if(getInDegrees()) 
+            angVec *= SimTK_RADIAN_TO_DEGREE;   
+
+        // FILL KINEMATICS ARRAY
+        rAccs.append(3, &vec[0]);
+        rAccs.append(3, &angVec[0]);
+    }
+
+    // Get Accelerations for kinematics of COM
+    if(_includeCOM){
+        // Get the body acceleration in ground
+        vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
 
-        // Get Accelerations for kinematics of COM
-        if(_includeCOM){
-            // Get the body acceleration in ground
-            vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
+        // FILL KINEMATICS ARRAY
+        rAccs.append(3, &vec[0]);
+    }
 
-            // FILL KINEMATICS ARRAY
-            _comIndAccs.append(3, &vec[0]);
+    // Get induced constraint reactions for contributor
+    if(_reportConstraintReactions){
+        for(int j=0; j<_constraintSet.getSize(); j++){
+            rAccs.append(_constraintSet[j].getRecordValues(s_analysis));
         }
+    }
 
-        // Get induced constraint reactions for contributor
-        if(_reportConstraintReactions){
-            for(int j=0; j<_constraintSet.getSize(); j++){
-                _constraintReactions.append(_constraintSet[j].getRecordValues(s_analysis));
-            }
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute and record the results.
+ *
+ * This method, for the purpose of example, records the position and
+ * orientation of each body in the model.  You will need to customize it
+ * to perform your analysis.
+ *
+ * @param aT Current time in the simulation.
+ * @param aX Current values of the controls.
+ * @param aY Current values of the states: includes generalized coords and speeds
+ */
+int InducedAccelerations::record(const SimTK::State& s)
+{
+    double aT = s.getTime();
+    cout << "time = " << aT << endl;
+
+    SimTK::Vector Q = s.getQ();
+
+    // Reset Accelerations for coordinates at this time step
+    for(int i=0;i<_coordSet.getSize();i++) {
+        _coordIndAccs[i]->setSize(0);
+    }
+
+    // Reset Accelerations for bodies at this time step
+    for(int i=0;i<_bodySet.getSize();i++) {
+        _bodyIndAccs[i]->setSize(0);
+    }
+
+    // Reset Accelerations for system center of mass at this time step
+    _comIndAccs.setSize(0);
+    _constraintReactions.setSize(0);
+
+    Array<bool> constraintOn(false, _constraintSet.getSize());
+    SimTK::State s_analysis;
+    if(_externalForces.getSize()>0 || !_analysisStateIsBuilt) {
+        s_analysis = _model->getWorkingState();
+
+        _model->initStateWithoutRecreatingSystem(s_analysis);
+        // Just need to set current time and position to determine state of constraints
+        s_analysis.setTime(aT);
+        s_analysis.setQ(Q);
+
+        // Check the external forces and determine if contact constraints should be applied at this time
+        // and turn constraint on if it should be.
+        constraintOn = applyContactConstraintAccordingToExternalForces(s_analysis);
+
+        // Hang on to a state that has the right flags for contact constraints turned on/off
+        _model->setPropertiesFromState(s_analysis);
+        // Use this state for the remainder of this step (record)
+        s_analysis = _model->getMultibodySystem().realizeTopology();
+        // DO NOT recreate the system, will lose location of constraint
+        _model->initStateWithoutRecreatingSystem(s_analysis);
+
+        // Without external forces the contact constraints never move, so
+        // the same analysis state serves every time step.
+        if(_externalForces.getSize()==0) {
+            _analysisState = s_analysis;
+            _analysisStateIsBuilt = true;
         }
+    }
+    else {
+        s_analysis = _analysisState;
+    }
+
+    // Solve for each force contributor to the system acceleration.
+    // "total" pushes the conditions of the constraints back to the model, so
+    // it is solved first on the analysis state itself.  The others only set
+    // flags in their own copy of the analysis state and are solved
+    // concurrently.
+    int nContributors = _contributors.getSize();
+    std::vector<Array<double> > accs(nContributors, Array<double>(0.0));
+    int first = 0;
+    if(nContributors>0 && _contributors[0]=="total") {
+        solveForContributor(s_analysis, s, 0, constraintOn, accs[0]);
+        first = 1;
+    }
 
+    // Rebuild the list of actuators before the threads read it
+    _model->updActuators();
+
+    int nThreads = _numThreads>0 ? _numThreads :
+        (int)std::thread::hardware_concurrency();
+    if(nThreads > nContributors-first) nThreads = nContributors-first;
+    if(nThreads < 1 || _hasPathForces) nThreads = 1;
+    std::atomic<int> next(first);
+    std::vector<SimTK::State> states(nThreads-1, s_analysis);
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto solveContributors = [&](SimTK::State& ks, int k) {
+        try {
+            for(int c=next++; c<nContributors; c=next++)
+                solveForContributor(ks, s, c, constraintOn, accs[c]);
+        } catch(...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int k=0; k<nThreads-1; k++)
+        threads.push_back(std::thread(solveContributors, std::ref(states[k]), k));
+    solveContributors(s_analysis, nThreads-1);
+    for(size_t k=0; k<threads.size(); k++) threads[k].join();
+    for(int k=0; k<nThreads; k++)
+        if(errors[k]) std::rethrow_exception(errors[k]);
+
+    // Gather the accelerations in the order of the contributors
+    int nc = _coordSet.getSize();
+    int nb = _bodySet.getSize();
+    for(int c=0; c<nContributors; c++) {
+        const Array<double>& acc = accs[c];
+        int k = 0;
+        for(int i=0; i<nc; i++, k++)
+            _coordIndAccs[i]->append(acc[k]);
+        for(int i=0; i<nb; i++, k+=6)
+            _bodyIndAccs[i]->append(6, &acc[k]);
+        if(_includeCOM) {
+            _comIndAccs.append(3, &acc[k]);
+            k += 3;
+        }
+        if(_reportConstraintReactions && k<acc.getSize())
+            _constraintReactions.append(acc.getSize()-k, &acc[k]);
     } // End cycling through contributors at this time step
 
     // Set the accelerations of coordinates into their storages
-    int nc = _coordSet.getSize();
     for(int i=0; i<nc; i++) {
         _storeInducedAccelerations[i]->append(aT, _coordIndAccs[i]->getSize(),&(_coordIndAccs[i]->get(0)));
     }
 
     // Set the accelerations of bodies into their storages
-    int nb = _bodySet.getSize();
     for(int i=0; i<nb; i++) {
         _storeInducedAccelerations[nc+i]->append(aT, _bodyIndAccs[i]->getSize(),&(_bodyIndAccs[i]->get(0)));
     }
@@ -809,6 +925,7 @@ void InducedAccelerations::initialize(const SimTK::State& s)
 
     SimTK::State s_copy = s;
     double time = s_copy.getTime();
+    _analysisStateIsBuilt = false;
 
     _externalForces.setSize(0);
 
@@ -830,6 +947,12 @@ void InducedAccelerations::initialize(const SimTK::State& s)
         }
     }
 
+    // Paths are computed in the model, so they cannot be shared by threads
+    _hasPathForces = false;
+    for(int i=0; i<_model->getForceSet().getSize(); i++)
+        if(_model->getForceSet().get(i).hasGeometryPath())
+            _hasPathForces = true;
+
     // Get value for gravity
     _gravity = _model->getGravity();
 
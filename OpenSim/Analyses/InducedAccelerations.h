@@ -30,6 +30,7 @@
 #include <OpenSim/Common/PropertyBool.h>
 #include <OpenSim/Common/PropertyObj.h>
 #include <OpenSim/Common/PropertyDbl.h>
+#include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Common/PropertyStrArray.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 // Header to define analysis (DLL) interface
@@ -104,6 +105,10 @@ protected:
     PropertyBool _reportConstraintReactionsProp;
     bool &_reportConstraintReactions;
 
+    /** Number of threads used to solve for the contributors. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     /** Storages for recording induced accelerations for specified coordinates and/or bodies. */
     Array<Storage *> _storeInducedAccelerations;
     Storage* _storeConstraintReactions;
@@ -125,6 +130,16 @@ protected:
     // Hold the actual model gravity since we will be changing it back and forth from 0
     SimTK::Vec3 _gravity;
 
+    // Analysis state reused at every time step when there are no external
+    // forces to replace with contact constraints
+    SimTK::State _analysisState;
+    bool _analysisStateIsBuilt;
+
+    // Whether a force of the model has a GeometryPath. Paths keep their
+    // points and wrapping in the model rather than in the state, so the
+    // contributors are then solved on one thread.
+    bool _hasPathForces;
+
 
 //=============================================================================
 // METHODS
@@ -187,6 +202,8 @@ public:
     // GET AND SET
     //-------------------------------------------------------------------------
     virtual void setModel(Model &aModel);
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
+    int getNumThreads() const { return _numThreads; }
 
     //-------------------------------------------------------------------------
     // INTEGRATION
@@ -210,6 +227,8 @@ public:
 protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s);
+    void solveForContributor(SimTK::State& s_analysis, const SimTK::State& s,
+        int c, const Array<bool>& constraintOn, Array<double>& rAccs);
     void constructDescription();
     void assembleContributors();
     Array<std::string> constructColumnLabelsForCoordinate();
@@ -226,6 +226,7 @@ void InverseDynamics::
 deleteStorage()
 {
     delete _storage; _storage = NULL;
+    _storageList.setSize(0);
 }
 
 //=============================================================================
@@ -147,6 +147,7 @@ void MuscleAnalysis::setNull()
     _coordinateListProp.getValueStrArray().setSize(1);
     _coordinateListProp.getValueStrArray().updElt(0) = "all";
     _computeMoments = true;
+    _numThreadsProp.setValue(1);
 }
 //_____________________________________________________________________________
 /**
@@ -170,6 +171,11 @@ void MuscleAnalysis::setupProperties()
     _computeMomentsProp.setName("compute_moments");
     _propertySet.append( &_computeMomentsProp );
 
+    _numThreadsProp.setComment("Number of threads used to compute moment "
+        "arms. A value of 0 uses one thread per processor.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
 }
 //-----------------------------------------------------------------------------
 // DESCRIPTION
@@ -210,6 +216,7 @@ void MuscleAnalysis::allocateStorageObjects()
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    _maSolver.reset();
 
     // FOR MOMENT ARMS AND MOMEMTS
     if(_computeMoments) {
@@ -416,6 +423,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
     _coordinateListProp = aAnalysis._coordinateListProp;
     _computeMomentsProp = aAnalysis._computeMomentsProp;
     _computeMoments = _computeMomentsProp.getValueBool();
+    _numThreadsProp = aAnalysis._numThreadsProp;
     allocateStorageObjects();
 
     return (*this);
@@ -647,23 +655,36 @@ int MuscleAnalysis::record(const SimTK::State& s)
 
     if (_computeMoments){
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        // All moment arms are solved at once, so that the coupling of each
+        // coordinate and the generalized forces of each path are computed
+        // only once.
+        Array<const Coordinate*> coordinates;
+        for(int i=0; i<nq; i++)
+            coordinates.append(_momentArmStorageArray[i]->q);
+        Array<const GeometryPath*> paths;
+        for(int j=0; j<nm; j++)
+            paths.append(&_muscleArray[j]->getGeometryPath());
+
+        if(!_maSolver)
+            _maSolver.reset(new MomentArmSolver(*_model));
+        _maSolver->setNumThreads(_numThreadsProp.getValueInt());
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        SimTK::Matrix momentArms;
+        _maSolver->solve(s, coordinates, paths, momentArms);
+
         for(int i=0; i<nq; i++) {
 
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(i,j);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -29,6 +29,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 #include <OpenSim/Simulation/Model/Muscle.h>
@@ -87,6 +88,9 @@ private:
     /** Compute moments and moment arms. */
     PropertyBool _computeMomentsProp;
 
+    /** Number of threads used to compute moment arms. */
+    PropertyInt _numThreadsProp;
+
     /** Pennation angle storage. */
     Storage *_pennationAngleStore;
     /** Muscle-tendon length storage. */
@@ -141,6 +145,9 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+    /** Solver for the moment arms of all active muscles at once. */
+    SimTK::NullOnCopyUniquePtr<MomentArmSolver> _maSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -218,6 +225,12 @@ public:
     bool getComputeMoments() const {
         return _computeMoments;
     }
+    void setNumThreads(int aNumThreads) {
+        _numThreadsProp.setValue(aNumThreads);
+    }
+    int getNumThreads() const {
+        return _numThreadsProp.getValueInt();
+    }
 #ifndef SWIG
     const ArrayPtrs<StorageCoordinatePair>& getMomentArmStorageArray() const { return _momentArmStorageArray; }
 #endif
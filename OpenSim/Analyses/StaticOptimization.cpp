@@ -57,6 +57,7 @@ using namespace std;
 StaticOptimization::~StaticOptimization()
 {
     deleteStorage();
+    deleteOptimizer();
     delete _modelWorkingCopy;
     if(_ownsForceSet) delete _forceSet;
 }
@@ -117,7 +118,6 @@ operator=(const StaticOptimization &aStaticOptimization)
     // BASE CLASS
     Analysis::operator=(aStaticOptimization);
 
-    _modelWorkingCopy = aStaticOptimization._modelWorkingCopy;
     _numCoordinateActuators = aStaticOptimization._numCoordinateActuators;
     _useModelForceSet = aStaticOptimization._useModelForceSet;
     _activationExponent=aStaticOptimization._activationExponent;
@@ -143,6 +143,8 @@ void StaticOptimization::setNull()
     _forceStorage = NULL;
     _ownsForceSet = false;
     _forceSet = NULL;
+    _target = NULL;
+    _optimizer = NULL;
     _activationExponent=2;
     _useMusclePhysiology=true;
     _numCoordinateActuators = 0;
@@ -228,6 +230,10 @@ allocateStorage()
     _forceStorage->setDescription(getDescription());
     _forceStorage->setColumnLabels(getColumnLabels());
 
+    // Keep references to all storages in a list for uniform access
+    _storageList.append(_activationStorage);
+    _storageList.append(_forceStorage);
+    _storageList.setMemoryOwner(false);
 }
 
 
@@ -243,6 +249,17 @@ deleteStorage()
 {
     delete _activationStorage; _activationStorage = NULL;
     delete _forceStorage; _forceStorage = NULL;
+    _storageList.setSize(0);
+}
+//_____________________________________________________________________________
+/**
+ * Delete the optimization target and optimizer.
+ */
+void StaticOptimization::
+deleteOptimizer()
+{
+    delete _optimizer; _optimizer = NULL;
+    delete _target; _target = NULL;
 }
 
 //=============================================================================
@@ -339,37 +356,40 @@ record(const SimTK::State& s)
     //_optimizationConvergenceTolerance = 1e-004;
     //_maxIterations = 2000;
 
-    // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
-    target.setStatesStore(_statesStore);
-    target.setStatesSplineSet(_statesSplineSet);
-    target.setActivationExponent(_activationExponent);
-    target.setDX(_numericalDerivativeStepSize);
-
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
-    // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
-
-    // Optimizer options
-    //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
-    optimizer->setDiagnosticsLevel(_printLevel);
-    //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
-    optimizer->setConvergenceTolerance(_convergenceCriterion);
-    //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
-    optimizer->setMaxIterations(_maximumIterations);
-    optimizer->useNumericalGradient(false);
-    optimizer->useNumericalJacobian(false);
-    if(algorithm == SimTK::InteriorPoint) {
-        // Some IPOPT-specific settings
-        optimizer->setLimitedMemoryHistory(500); // works well for our small systems
-        optimizer->setAdvancedBoolOption("warm_start",true);
-        optimizer->setAdvancedRealOption("obj_scaling_factor",1);
-        optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+    // Optimization target and optimizer, created at the first frame after
+    // begin() and reused for the following frames
+    _modelWorkingCopy->setAllControllersEnabled(false);
+    if(!_target) {
+        _target = new StaticOptimizationTarget(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+        _target->setStatesStore(_statesStore);
+        _target->setStatesSplineSet(_statesSplineSet);
+        _target->setActivationExponent(_activationExponent);
+        _target->setDX(_numericalDerivativeStepSize);
+
+        _optimizer = new SimTK::Optimizer(*_target, algorithm);
+
+        // Optimizer options
+        //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
+        _optimizer->setDiagnosticsLevel(_printLevel);
+        //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
+        _optimizer->setConvergenceTolerance(_convergenceCriterion);
+        //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
+        _optimizer->setMaxIterations(_maximumIterations);
+        _optimizer->useNumericalGradient(false);
+        _optimizer->useNumericalJacobian(false);
+        if(algorithm == SimTK::InteriorPoint) {
+            // Some IPOPT-specific settings
+            _optimizer->setLimitedMemoryHistory(500); // works well for our small systems
+            _optimizer->setAdvancedBoolOption("warm_start",true);
+            _optimizer->setAdvancedRealOption("obj_scaling_factor",1);
+            _optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+        }
     }
+    StaticOptimizationTarget& target = *_target;
 
     // Parameter bounds
     SimTK::Vector lowerBounds(na), upperBounds(na);
@@ -382,7 +402,8 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    // The initial guess is the solution of the previous frame (zeros after
+    // begin() or a failed optimization)
 
     // Static optimization
     _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
@@ -395,11 +416,18 @@ record(const SimTK::State& s)
     //QueryPerformanceFrequency(&frequency);
     //QueryPerformanceCounter(&start);
 
+    bool converged = true;
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        // Solve directly if the problem is a quadratic program, otherwise
+        // (or if that fails) with the optimizer.  The direct solve is exact,
+        // so only the maximum number of iterations applies to it.
+        if(!target.solveQuadraticProgram(lowerBounds, upperBounds,
+                                         _maximumIterations, _parameters))
+            _optimizer->optimize(_parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
+        converged = false;
         cout << ex.getMessage() << endl;
         cout << "OPTIMIZATION FAILED..." << endl;
         cout << endl;
@@ -496,6 +524,8 @@ record(const SimTK::State& s)
 
     _forceStorage->append(sWorkingCopy.getTime(),na,&forces[0]);
 
+    if(!converged) _parameters = 0;
+
     return 0;
 }
 //_____________________________________________________________________________
@@ -515,6 +545,7 @@ begin(SimTK::State& s )
     if(!proceed()) return(0);
 
     // Make a working copy of the model
+    deleteOptimizer();
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
     _modelWorkingCopy->initSystem();
@@ -40,10 +40,15 @@
 //=============================================================================
 /**
  */
+namespace SimTK {
+class Optimizer;
+}
+
 namespace OpenSim { 
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
@@ -95,6 +100,11 @@ protected:
 
     Model *_modelWorkingCopy;
 
+    /** Target and optimizer created at the first frame after begin() and
+    reused, starting from the previous solution, for the following frames. */
+    StaticOptimizationTarget *_target;
+    SimTK::Optimizer *_optimizer;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -116,6 +126,7 @@ private:
     void constructColumnLabels();
     void allocateStorage();
     void deleteStorage();
+    void deleteOptimizer();
 
 public:
     //--------------------------------------------------------------------------
@@ -147,6 +147,170 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Solve for the parameters directly as a quadratic program.
+ *
+ * With an activation exponent of 2 the performance is the sum of the squared
+ * parameters and, since the constraints are linear in the parameters, the
+ * problem is a quadratic program, which is solved by the static
+ * solveQuadraticProgram().  The active set starts from that of the previous
+ * solve, so that for slowly changing frames the first iteration is usually
+ * the last.
+ *
+ * prepareToOptimize() must have been called for the current state.
+ *
+ * @param lowerBounds Lower bounds of the parameters.
+ * @param upperBounds Upper bounds of the parameters.
+ * @param aMaxIterations Maximum number of active sets to try.
+ * @param x Solution, left unchanged if none is found.
+ * @return true if a solution was found, false if the problem should be
+ * solved by an optimizer instead.
+ */
+bool StaticOptimizationTarget::
+solveQuadraticProgram(const Vector &lowerBounds, const Vector &upperBounds,
+    int aMaxIterations, Vector &x)
+{
+#ifndef USE_LINEAR_CONSTRAINT_MATRIX
+    return false;
+#else
+    if(_activationExponent != 2.0) return false;
+    return solveQuadraticProgram(_constraintMatrix, _constraintVector,
+        lowerBounds, upperBounds, aMaxIterations, _activeBounds, x);
+#endif
+}
+//______________________________________________________________________________
+/**
+ * Minimize x^T x subject to C x + d = 0 and lowerBounds <= x <= upperBounds.
+ *
+ * The quadratic program is solved by an active-set method: parameters held
+ * at a bound are fixed, the others are the minimum-norm solution of the
+ * constraints, and bounds are added for parameters that exceed them and
+ * released when their multipliers have the wrong sign.  Each active set is
+ * solved exactly, up to rounding, so the method either finds the solution
+ * or stops after aMaxIterations active sets; unlike an optimizer, it has no
+ * convergence tolerance to set.
+ *
+ * @param C Constraint matrix.
+ * @param d Constraint vector.
+ * @param lowerBounds Lower bounds of the parameters.
+ * @param upperBounds Upper bounds of the parameters.
+ * @param aMaxIterations Maximum number of active sets to try.
+ * @param rActiveBounds Active set for each parameter: -1 if held at its
+ * lower bound, 1 if held at its upper bound and 0 if free.  It is the
+ * starting active set, if it has one entry per parameter, and is left at the
+ * last active set tried.
+ * @param x Solution, left unchanged if none is found.
+ * @return true if a solution was found, false if the constraints cannot be
+ * met within the bounds or aMaxIterations was reached.
+ */
+bool StaticOptimizationTarget::
+solveQuadraticProgram(const Matrix &C, const Vector &d,
+    const Vector &lowerBounds, const Vector &upperBounds, int aMaxIterations,
+    Array<int> &rActiveBounds, Vector &x)
+{
+    int np = C.ncol();
+    int nc = C.nrow();
+    if(rActiveBounds.getSize() != np) {
+        rActiveBounds.setSize(np);
+        for(int p=0; p<np; p++) rActiveBounds[p] = 0;
+    }
+
+    double scale = 1.0;
+    for(int c=0; c<nc; c++) scale = max(scale, fabs(d[c]));
+    const double tolConstraints = 1e-8*scale;
+    const double tolBounds = 1e-10;
+    const double tolMultipliers = 1e-8;
+
+    Vector xp(np), y(nc), r(nc);
+    Matrix m(nc,nc);
+    Array<int> freeIndices;
+    for(int iter=0; iter<aMaxIterations; iter++) {
+        // FIX THE PARAMETERS AT THEIR BOUNDS
+        freeIndices.setSize(0);
+        r = -d;
+        for(int p=0; p<np; p++) {
+            if(rActiveBounds[p]==0) {
+                xp[p] = 0.0;
+                freeIndices.append(p);
+                continue;
+            }
+            xp[p] = (rActiveBounds[p] < 0) ? lowerBounds[p] : upperBounds[p];
+            for(int c=0; c<nc; c++) r[c] -= C(c,p)*xp[p];
+        }
+        int nf = freeIndices.getSize();
+
+        // MINIMUM-NORM SOLUTION FOR THE FREE PARAMETERS
+        // x_free = C_free^T y where (C_free C_free^T) y = r.  The multipliers
+        // of the constraints are -2y.
+        y = 0.0;
+        if(nc > 0) {
+            for(int c1=0; c1<nc; c1++) {
+                for(int c2=0; c2<=c1; c2++) {
+                    double sum = 0.0;
+                    for(int f=0; f<nf; f++)
+                        sum += C(c1,freeIndices[f])*C(c2,freeIndices[f]);
+                    m(c1,c2) = m(c2,c1) = sum;
+                }
+            }
+            SimTK::FactorQTZ qtz(m);
+            qtz.solve(r, y);
+        }
+        for(int f=0; f<nf; f++) {
+            int p = freeIndices[f];
+            for(int c=0; c<nc; c++) xp[p] += C(c,p)*y[c];
+        }
+
+        // The fixed parameters may leave the constraints unsatisfiable; start
+        // over from no bounds, unless none are held.
+        bool satisfied = true;
+        for(int c=0; c<nc; c++) {
+            double residual = d[c];
+            for(int p=0; p<np; p++) residual += C(c,p)*xp[p];
+            if(fabs(residual) > tolConstraints) { satisfied = false; break; }
+        }
+        if(!satisfied) {
+            if(nf==np) return false;
+            for(int p=0; p<np; p++) rActiveBounds[p] = 0;
+            continue;
+        }
+
+        // ADD BOUNDS THAT ARE EXCEEDED
+        bool added = false;
+        for(int f=0; f<nf; f++) {
+            int p = freeIndices[f];
+            if(xp[p] < lowerBounds[p]-tolBounds) {
+                rActiveBounds[p] = -1;
+                added = true;
+            } else if(xp[p] > upperBounds[p]+tolBounds) {
+                rActiveBounds[p] = 1;
+                added = true;
+            }
+        }
+        if(added) continue;
+
+        // RELEASE THE BOUND WHOSE MULTIPLIER MOST HAS THE WRONG SIGN
+        int release = -1;
+        double worst = tolMultipliers;
+        for(int p=0; p<np; p++) {
+            if(rActiveBounds[p]==0) continue;
+            double g = 2.0*xp[p];
+            for(int c=0; c<nc; c++) g -= 2.0*C(c,p)*y[c];
+            double violation = (rActiveBounds[p] < 0) ? -g : g;
+            if(violation > worst) {
+                worst = violation;
+                release = p;
+            }
+        }
+        if(release < 0) {
+            x = xp;
+            return true;
+        }
+        rActiveBounds[release] = 0;
+    }
+
+    return false;
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
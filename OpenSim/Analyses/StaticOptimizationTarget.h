@@ -69,6 +69,10 @@ private:
     const Storage *_statesStore;
     GCVSplineSet _statesSplineSet;
 
+    /** Bound at which each parameter was held by the last quadratic program
+    solve (-1 lower, 1 upper, 0 neither). */
+    Array<int> _activeBounds;
+
 protected:
     double _activationExponent;
     bool   _useMusclePhysiology;
@@ -113,6 +117,13 @@ public:
         double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
 
     bool prepareToOptimize(SimTK::State& s, double *x);
+    bool solveQuadraticProgram(const SimTK::Vector &lowerBounds,
+        const SimTK::Vector &upperBounds, int aMaxIterations,
+        SimTK::Vector &x);
+    static bool solveQuadraticProgram(const SimTK::Matrix &C,
+        const SimTK::Vector &d, const SimTK::Vector &lowerBounds,
+        const SimTK::Vector &upperBounds, int aMaxIterations,
+        Array<int> &rActiveBounds, SimTK::Vector &x);
 
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
@@ -78,6 +78,9 @@ protected:
     int _capacityIncrement;
     /** Array of pointers to objects of type T. */
     T **_array;
+    /** Number of times the contents of the array have been changed.  Used by
+    owners that keep an index of the array to detect when it is stale. */
+    unsigned int _modificationCount;
 
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
@@ -144,6 +147,7 @@ void setNull()
     _capacityIncrement = -1;
     _capacity = 0;
     _array = NULL;
+    _modificationCount = 0;
 }
 
 public:
@@ -166,6 +170,7 @@ void clearAndDestroy()
     }
 
     _size = 0;
+    _modificationCount++;
 }
 
 
@@ -209,6 +214,7 @@ ArrayPtrs<T>& operator=(const ArrayPtrs<T> &aArray)
 
     // TAKE OWNERSHIP OF MEMORY
     _memoryOwner = true;
+    _modificationCount++;
 
     return(*this);
 }
@@ -524,6 +530,7 @@ bool setSize(int aSize)
             }
         }
         _size = aSize;
+        _modificationCount++;
     }
 
     return(true);
@@ -542,6 +549,20 @@ int getSize() const
 /** Alternate name for getSize(). **/
 int size() const {return getSize();}
 
+//_____________________________________________________________________________
+/**
+ * Get the number of times the contents of the array have been changed by
+ * assigning, appending, inserting, setting or removing elements.  The
+ * count only ever increases, so an index built from the array is current as
+ * long as the count has not changed since it was built.
+ *
+ * @return Modification count.
+ */
+unsigned int getModificationCount() const
+{
+    return(_modificationCount);
+}
+
 //-----------------------------------------------------------------------------
 // INDEX
 //-----------------------------------------------------------------------------
@@ -634,6 +655,7 @@ bool append(T *aObject)
     // SET
     _array[_size] = aObject;
     _size++;
+    _modificationCount++;
 
     return(true);
 }
@@ -714,6 +736,7 @@ bool insert(int aIndex,T *aObject)
     // SET
     _array[aIndex] = aObject;
     _size++;
+    _modificationCount++;
 
     return(true);
 }
@@ -754,6 +777,7 @@ bool remove(int aIndex)
         _array[i] = _array[i+1];
     }
     _array[_size] = NULL;
+    _modificationCount++;
 
     return(true);
 }
@@ -810,6 +834,7 @@ bool set(int aIndex,T *aObject)
     // SET
     if(getMemoryOwner() && (_array[aIndex]!=NULL)) delete _array[aIndex];
     _array[aIndex] = aObject;
+    _modificationCount++;
 
     return(true);
 }
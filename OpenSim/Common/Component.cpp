@@ -232,6 +232,7 @@ void Component::addToSystem(SimTK::MultibodySystem& system) const
     extendAddToSystem(system);
     componentsAddToSystem(system);
     extendAddToSystemAfterSubcomponents(system);
+    formStateVariableTable();
 }
 
 // Base class implementation of virtual method.
@@ -267,6 +268,34 @@ void Component::componentsAddToSystem(SimTK::MultibodySystem& system) const
         _components[i]->addToSystem(system);
 }
 
+void Component::formStateVariableTable() const
+{
+    // This Component's state variables in order of allocation
+    _allStateVariables.clear();
+    _allStateVariables.resize((unsigned)_namedStateVariableInfo.size());
+    std::map<std::string, StateVariableInfo>::const_iterator it;
+    for(it = _namedStateVariableInfo.begin(); 
+        it != _namedStateVariableInfo.end(); ++it){
+        _allStateVariables[it->second.order] = it->second.stateVariable.get();
+    }
+    // followed by those of its subcomponents
+    for(unsigned int i=0; i<_components.size(); i++){
+        const SimTK::Array_<const StateVariable*>& subTable =
+            _components[i]->_allStateVariables;
+        for(unsigned int j=0; j<subTable.size(); j++)
+            _allStateVariables.push_back(subTable[j]);
+    }
+}
+
+bool Component::hasStateVariableTable() const
+{
+    // The table is cleared with the state allocations; check that it still
+    // accounts for every state variable, in case subcomponents were
+    // added or reset since.
+    return !_allStateVariables.empty() &&
+        (int)_allStateVariables.size() == getNumStateVariables();
+}
+
 void Component::initStateFromProperties(SimTK::State& state) const
 {
     extendInitStateFromProperties(state);
@@ -697,9 +726,16 @@ SimTK::Vector Component::
     getStateVariableValues(const SimTK::State& state) const
 {
     int nsv = getNumStateVariables();
-    Array<std::string> names = getStateVariableNames();
-
     Vector stateVariableValues(nsv, SimTK::NaN);
+
+    if(hasStateVariableTable()){
+        for(int i=0; i<nsv; ++i){
+            stateVariableValues[i]=_allStateVariables[i]->getValue(state);
+        }
+        return stateVariableValues;
+    }
+
+    Array<std::string> names = getStateVariableNames();
     for(int i=0; i<nsv; ++i){
         stateVariableValues[i]=getStateVariableValue(state, names[i]);
     }
@@ -715,14 +751,51 @@ void Component::
     int nsv = getNumStateVariables();
     SimTK_ASSERT(values.size() == nsv, 
         "Component::setStateVariableValues() number values does not match number of state variables."); 
-    Array<std::string> names = getStateVariableNames();
+    if(hasStateVariableTable()){
+        for(int i=0; i<nsv; ++i){
+            _allStateVariables[i]->setValue(state, values[i]);
+        }
+        return;
+    }
 
-    Vector stateVariableValues(nsv, SimTK::NaN);
+    Array<std::string> names = getStateVariableNames();
     for(int i=0; i<nsv; ++i){
         setStateVariableValue(state, names[i], values[i]);
     }
 }
 
+// Get the index of a state variable in the order of getStateVariableNames().
+int Component::getStateVariableIndex(const std::string& name) const
+{
+    const StateVariable* rsv = findStateVariable(name);
+    if(rsv && hasStateVariableTable()){
+        for(unsigned int i=0; i<_allStateVariables.size(); ++i){
+            if(_allStateVariables[i] == rsv) return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Get the value of a state variable by its index in the order of
+// getStateVariableNames().
+double Component::
+    getStateVariableValue(const SimTK::State& s, int index) const
+{
+    SimTK_INDEXCHECK_ALWAYS(index, (int)_allStateVariables.size(),
+        "Component::getStateVariableValue()");
+    return _allStateVariables[index]->getValue(s);
+}
+
+// Set the value of a state variable by its index in the order of
+// getStateVariableNames().
+void Component::
+    setStateVariableValue(State& s, int index, double value) const
+{
+    SimTK_INDEXCHECK_ALWAYS(index, (int)_allStateVariables.size(),
+        "Component::setStateVariableValue()");
+    _allStateVariables[index]->setValue(s, value);
+}
+
 // Set the derivative of a state variable computed by this Component by name.
 void Component::
     setStateVariableDerivativeValue(const State& state, 
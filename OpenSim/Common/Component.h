@@ -677,6 +677,37 @@ public:
      */
     void setStateVariableValues(SimTK::State& state, const SimTK::Vector& values);
 
+    /**
+     * Get the index of a state variable in the order returned by
+     * getStateVariableNames(), for use with the index-based access methods
+     * below. The name is resolved as by getStateVariableValue(), so it is
+     * best to look indices up once, outside of loops.
+     *
+     * @param name    the name (string) of the state variable of interest
+     * @return the index of the state variable, or -1 if it is not found or
+     *         the system has not been created (e.g. by Model::initSystem())
+     */
+    int getStateVariableIndex(const std::string& name) const;
+
+    /**
+     * Get the value of a state variable by its index in the order returned
+     * by getStateVariableNames() (see getStateVariableIndex()).
+     *
+     * @param state   the State for which to get the value
+     * @param index   the index of the state variable
+     */
+    double getStateVariableValue(const SimTK::State& state, int index) const;
+
+    /**
+     * Set the value of a state variable by its index in the order returned
+     * by getStateVariableNames() (see getStateVariableIndex()).
+     *
+     * @param state  the State for which to set the value
+     * @param index  the index of the state variable
+     * @param value  the value to set
+     */
+    void setStateVariableValue(SimTK::State& state, int index, double value) const;
+
     /**
      * Get the value of a state variable derivative computed by this Component.
      *
@@ -704,6 +735,31 @@ public:
      */
     void setDiscreteVariableValue(SimTK::State& state, const std::string& name, double value) const;
 
+#ifndef SWIG
+    /**
+     * A handle to a cache variable of type T allocated by this Component,
+     * returned by addCacheVariable(). Components that access a cache
+     * variable on every realization can keep the handle and pass it to the
+     * cache variable accessors in place of the name, which avoids looking
+     * the name up on every call. The type is fixed when the handle is
+     * created, so it cannot be used to access the value as another type.
+     *
+     * A handle remains valid as long as the cache variable is added again,
+     * with the same name, each time the Component is added to a System.
+     */
+    template <class T> class CacheVariable {
+    public:
+        /** Construct an invalid handle. */
+        CacheVariable() : _slot(-1) {}
+        /** Whether this handle was returned by addCacheVariable(). */
+        bool isValid() const { return _slot >= 0; }
+    private:
+        explicit CacheVariable(int slot) : _slot(slot) {}
+        int _slot;
+        friend class Component;
+    };
+#endif
+
     /**
      * Get the value of a cache variable allocated by this Component by name.
      *
@@ -882,6 +938,77 @@ public:
             throw Exception(msg.str(),__FILE__,__LINE__);
         }   
     }
+
+#ifndef SWIG
+    /**
+     * Get the value of a cache variable allocated by this Component using
+     * the handle returned by addCacheVariable().
+     */
+    template<typename T> const T& 
+    getCacheVariableValue(const SimTK::State& state, 
+                          const CacheVariable<T>& cv) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().getCacheEntry(
+            state, getCacheEntryIndex(cv._slot))).get();
+    }
+    /**
+     * Obtain a writable cache variable value allocated by this Component
+     * using the handle returned by addCacheVariable().
+     */
+    template<typename T> T& 
+    updCacheVariableValue(const SimTK::State& state, 
+                          const CacheVariable<T>& cv) const
+    {
+        return SimTK::Value<T>::downcast(getDefaultSubsystem().updCacheEntry(
+            state, getCacheEntryIndex(cv._slot))).upd();
+    }
+    /**
+     * Mark a cache variable value allocated by this Component as valid
+     * using the handle returned by addCacheVariable().
+     */
+    template<typename T> void 
+    markCacheVariableValid(const SimTK::State& state, 
+                           const CacheVariable<T>& cv) const
+    {
+        getDefaultSubsystem().markCacheValueRealized(state, 
+            getCacheEntryIndex(cv._slot));
+    }
+    /**
+     * Mark a cache variable value allocated by this Component as invalid
+     * using the handle returned by addCacheVariable().
+     */
+    template<typename T> void 
+    markCacheVariableInvalid(const SimTK::State& state, 
+                             const CacheVariable<T>& cv) const
+    {
+        getDefaultSubsystem().markCacheValueNotRealized(state, 
+            getCacheEntryIndex(cv._slot));
+    }
+    /**
+     * Whether a cache variable value allocated by this Component is valid,
+     * using the handle returned by addCacheVariable().
+     */
+    template<typename T> bool 
+    isCacheVariableValid(const SimTK::State& state, 
+                         const CacheVariable<T>& cv) const
+    {
+        return getDefaultSubsystem().isCacheValueRealized(state, 
+            getCacheEntryIndex(cv._slot));
+    }
+    /**
+     * Set a cache variable value allocated by this Component using the 
+     * handle returned by addCacheVariable(), and mark it as valid.
+     */
+    template<typename T> void 
+    setCacheVariableValue(const SimTK::State& state, 
+                          const CacheVariable<T>& cv, const T& value) const
+    {
+        SimTK::CacheEntryIndex ceIndex = getCacheEntryIndex(cv._slot);
+        SimTK::Value<T>::downcast(
+            getDefaultSubsystem().updCacheEntry(state, ceIndex)).upd() = value;
+        getDefaultSubsystem().markCacheValueRealized(state, ceIndex);
+    }
+#endif
     // End of Model Component State Accessors.
     //@} 
 
@@ -1457,16 +1584,26 @@ template <class T> friend class ComponentMeasure;
     @param[in]      dependsOnStage      
         This is the highest computational stage on which this cache entry's
         value computation depends. State changes at this level or lower will
-        invalidate the cache entry. **/ 
-    template <class T> void 
+        invalidate the cache entry.
+    @return A handle with which the cache variable can be accessed without
+        looking up its name. **/ 
+    template <class T> CacheVariable<T> 
     addCacheVariable(const std::string&     cacheVariableName,
                      const T&               variablePrototype, 
                      SimTK::Stage           dependsOnStage) const
     {
         // Note, cache index is invalid until the actual allocation occurs 
         // during realizeTopology.
-        _namedCacheVariableInfo[cacheVariableName] = 
-            CacheInfo(new SimTK::Value<T>(variablePrototype), dependsOnStage);
+        CacheInfo& ci = _namedCacheVariableInfo[cacheVariableName];
+        int slot = ci.slot;
+        ci = CacheInfo(new SimTK::Value<T>(variablePrototype), dependsOnStage);
+        // A cache variable added again keeps its handle.
+        if(slot < 0){
+            slot = (int)_cacheVariables.size();
+            _cacheVariables.push_back(&ci);
+        }
+        ci.slot = slot;
+        return CacheVariable<T>(slot);
     }
 
     
@@ -1503,6 +1640,22 @@ template <class T> friend class ComponentMeasure;
     const SimTK::CacheEntryIndex 
     getCacheVariableIndex(const std::string& name) const;
 
+private:
+    /* Get the index of the cache entry of a cache variable handle. */
+    const SimTK::CacheEntryIndex& getCacheEntryIndex(int slot) const
+    {
+        if(slot < 0 || slot >= (int)_cacheVariables.size()) {
+            std::stringstream msg;
+            msg << "Component::getCacheEntryIndex: ERR- invalid cache "
+                << "variable handle for component '" << getName() 
+                << "' of type " << getConcreteClassName();
+            throw Exception(msg.str(),__FILE__,__LINE__);
+        }
+        return _cacheVariables[slot]->index;
+    }
+
+protected:
+
     // End of System Creation and Access Methods.
 
     /** Utility method to find a component in the list of sub components of this
@@ -1571,6 +1724,13 @@ private:
     /// Invoke addToSystem() on the (sub)components of this Component.
     void componentsAddToSystem(SimTK::MultibodySystem& system) const;
 
+    /// Form _allStateVariables from the state variables of this Component
+    /// and of its subcomponents, whose tables must already be formed.
+    void formStateVariableTable() const;
+
+    /// Whether _allStateVariables is formed and up to date.
+    bool hasStateVariableTable() const;
+
     /// Invoke initStateFromProperties() on (sub)components of this Component
     void componentsInitStateFromProperties(SimTK::State& state) const;
 
@@ -1595,6 +1755,8 @@ private:
         _namedStateVariableInfo.clear();
         _namedDiscreteVariableInfo.clear();
         _namedCacheVariableInfo.clear();    
+        _cacheVariables.clear();
+        _allStateVariables.clear();
     }
 
     // Reset by clearing underlying system indices, disconnecting connectors and
@@ -1824,13 +1986,15 @@ private:
 
     // Structure to hold related info about cache variables 
     struct CacheInfo {
-        CacheInfo() {}
+        CacheInfo() : slot(-1) {}
         CacheInfo(SimTK::AbstractValue* proto,
                   SimTK::Stage          dependsOn)
-        :   prototype(proto), dependsOnStage(dependsOn) {}
+        :   prototype(proto), dependsOnStage(dependsOn), slot(-1) {}
         // Model
         SimTK::ClonePtr<SimTK::AbstractValue>   prototype;
         SimTK::Stage                            dependsOnStage;
+        // Position in _cacheVariables, which is the handle of the variable
+        int                                     slot;
         // System
         SimTK::CacheEntryIndex                  index;
     };
@@ -1857,6 +2021,14 @@ private:
     // Map names of cache entries of the Component to their individual 
     // cache information.
     mutable std::map<std::string, CacheInfo>            _namedCacheVariableInfo;
+    // Cache entries of the Component in the order they were added, indexed
+    // by the handles returned by addCacheVariable(). Entries point into
+    // _namedCacheVariableInfo and are cleared with it.
+    mutable std::vector<CacheInfo*>                     _cacheVariables;
+    // All continuous state variables of the Component and its subcomponents
+    // in the order of getStateVariableNames(), formed by addToSystem() so
+    // that they can be accessed without looking up their names.
+    mutable SimTK::Array_<const StateVariable*>         _allStateVariables;
 //==============================================================================
 };  // END of class Component
 //==============================================================================
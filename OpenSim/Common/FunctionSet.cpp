@@ -159,3 +159,29 @@ evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
         }
     }
 }
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions in the function set and their first and second
+ * derivatives.
+ *
+ * @param rValues Array containing the values of the functions.
+ * @param rFirstDerivatives Array containing the first derivatives.
+ * @param rSecondDerivatives Array containing the second derivatives.
+ * @param aX Value of the x independent variable.
+ * @see Function
+ */
+void FunctionSet::
+evaluate(Array<double> &rValues,Array<double> &rFirstDerivatives,
+         Array<double> &rSecondDerivatives,double aX) const
+{
+    int size = getSize();
+    rValues.setSize(size);
+    rFirstDerivatives.setSize(size);
+    rSecondDerivatives.setSize(size);
+
+    for(int i=0;i<size;i++) {
+        rValues[i] = evaluate(i,0,aX);
+        rFirstDerivatives[i] = evaluate(i,1,aX);
+        rSecondDerivatives[i] = evaluate(i,2,aX);
+    }
+}
@@ -75,6 +75,9 @@ public:
     virtual void
         evaluate(Array<double> &rValues,int aDerivOrder,
         double aX=0.0) const;
+    virtual void
+        evaluate(Array<double> &rValues,Array<double> &rFirstDerivatives,
+        Array<double> &rSecondDerivatives,double aX=0.0) const;
 
 //=============================================================================
 };  // END class FunctionSet
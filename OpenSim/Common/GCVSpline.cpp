@@ -448,6 +448,22 @@ getCoefficients() const
 //=============================================================================
 // EVALUATION
 //=============================================================================
+//_____________________________________________________________________________
+double GCVSpline::
+evaluate(int aDerivOrder,double aX,int &rInterval) const
+{
+    if(getSize()<=0) return(SimTK::NaN);
+
+    // The coefficients are those of the SimTK::Spline, and are brought up to
+    // date when it is created.
+    if(_function==NULL) _function = createSimTKFunction();
+
+    double workspace[8];
+    return(splder(aDerivOrder,_halfOrder,getSize(),aX,&_x[0],
+        &_coefficients[0],&rInterval,workspace));
+}
+
+//_____________________________________________________________________________
 double GCVSpline::
 getX(int aIndex) const
 {
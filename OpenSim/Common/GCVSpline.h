@@ -232,6 +232,21 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Evaluate the spline or one of its derivatives, starting the search for
+     * the knot interval that contains aX at rInterval.
+     *
+     * Splines with the same knots that are evaluated one after another at
+     * the same aX can pass the same rInterval, so that only the first one
+     * searches for the interval.
+     *
+     * @param aDerivOrder Order of the derivative to evaluate (0 for the value).
+     * @param aX Value of the independent variable.
+     * @param rInterval Knot interval to begin the search at, which receives
+     * the interval that contains aX.  Start with 0 if it is not known.
+     * @return Value of the spline or its derivative.
+     */
+    double evaluate(int aDerivOrder,double aX,int &rInterval) const;
 
 //=============================================================================
 };  // END class GCVSpline
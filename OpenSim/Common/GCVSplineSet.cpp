@@ -28,6 +28,10 @@
 
 // INCLUDES
 #include "GCVSplineSet.h"
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
 
 
 //=============================================================================
@@ -84,11 +88,14 @@ GCVSplineSet(const char *aFileName) :
  * the error variance assumed for each column in the Storage.  If different
  * variances should be set for the various columns, you will need to
  * construct each GCVSpline individually.
+ * @param aNumThreads Number of threads on which the splines are fit.  A value
+ * of 0 uses as many threads as there are processors.  The default is 1.
  * @see Storage
  * @see GCVSpline
  */
 GCVSplineSet::
-GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance)
+GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance,
+    int aNumThreads)
 {
     setNull();
     if(aStore==NULL) return;
@@ -100,7 +107,7 @@ GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance)
     ensureCapacity(2*vec->getSize());
 
     // CONSTRUCT
-    construct(aDegree,aStore,aErrorVariance);
+    construct(aDegree,aStore,aErrorVariance,aNumThreads);
 }
 
 
@@ -123,9 +130,12 @@ setNull()
  * @param aDegree Degree of the constructed splines (1, 3, 5, or 7).
  * @param aStore Storage object.
  * @param aErrorVariance Error variance for the data.
+ * @param aNumThreads Number of threads on which the splines are fit (0 for
+ * all processors).
  */
 void GCVSplineSet::
-construct(int aDegree,const Storage *aStore,double aErrorVariance)
+construct(int aDegree,const Storage *aStore,double aErrorVariance,
+    int aNumThreads)
 {
     if(aStore==NULL) return;
 
@@ -137,7 +147,16 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
     char tmp[32];
     std::string name;
 
+    // GATHER THE STATES HELD BY EVERY STATEVECTOR IN ONE PASS
+    // Columns beyond these (if the rows differ in length) are fetched one
+    // at a time below, with only the times at which they are present.
+    double *allTimes=NULL;
+    int nAllTimes = aStore->getTimeColumn(allTimes);
+    SimTK::Matrix block;
+    int nBlock = aStore->getDataColumns(0,aStore->getSmallestNumberOfStates(),block);
+
     // LOOP THROUGHT THE STATES
+    int firstSpline = getSize();
     int nTime=1,nData=1;
     double *times=NULL,*data=NULL;
     GCVSpline *spline;
@@ -145,8 +164,17 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
     for(int i=0;nData>0;i++) {
 
         // GET TIMES AND DATA
-        nTime = aStore->getTimeColumn(times,i);
-        nData = aStore->getDataColumn(i,data);
+        const double *splineTimes,*splineData;
+        if(i<nBlock) {
+            nTime = nData = nAllTimes;
+            splineTimes = allTimes;
+            splineData = &block(0,i);
+        } else {
+            nTime = aStore->getTimeColumn(times,i);
+            nData = aStore->getDataColumn(i,data);
+            splineTimes = times;
+            splineData = data;
+        }
 
         // CHECK
         if(nTime!=nData) {
@@ -167,16 +195,42 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
 
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
-        spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
+        spline = new GCVSpline(aDegree,nData,splineTimes,splineData,name,aErrorVariance);
 
         // ADD SPLINE
         adoptAndAppend(spline);
     }
     //printf("\n%d splines constructed.\n\n",i);
 
+    // FIT THE SPLINES
+    // The splines are independent, so they may be fit on aNumThreads threads.
+    // Each spline keeps its fit for evaluation (getArgumentSize() creates it),
+    // rather than the fit being repeated the first time it is evaluated.
+    int nSplines = getSize();
+    std::atomic<int> next(firstSpline);
+    int nThreads = aNumThreads>0 ? aNumThreads :
+        (int)std::thread::hardware_concurrency();
+    if(nThreads > nSplines-firstSpline) nThreads = nSplines-firstSpline;
+    if(nThreads < 1) nThreads = 1;
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto fitSplines = [&](int aThread) {
+        try {
+            for(int j=next++; j<nSplines; j=next++)
+                get(j).getArgumentSize();
+        } catch(...) {
+            errors[aThread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int t=1; t<nThreads; t++)
+        threads.push_back(std::thread(fitSplines, t));
+    fitSplines(0);
+    for(size_t t=0; t<threads.size(); t++) threads[t].join();
+    for(int t=0; t<nThreads; t++)
+        if(errors[t]) std::rethrow_exception(errors[t]);
+
     // CLEANUP
+    if(allTimes!=NULL) delete[] allTimes;
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
 }
@@ -199,6 +253,70 @@ getGCVSpline(int aIndex) const
     return(&func);
 }
 
+//=============================================================================
+// EVALUATION
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Evaluate all the splines in the set or their derivatives.  Each spline
+ * begins its search for the knot interval that contains aX at the interval
+ * found by the spline before it, so that when the splines share their knots
+ * only the first one searches.  Functions in the set that are not GCVSplines
+ * are evaluated as in FunctionSet.
+ *
+ * @param rValues Array containing the values of the functions.
+ * @param aDerivOrder Order of the derivative to evaluate.
+ * @param aX Value of the x independent variable.
+ */
+void GCVSplineSet::
+evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
+{
+    int size = getSize();
+    rValues.setSize(size);
+
+    int interval = 0;
+    for(int i=0;i<size;i++) {
+        const GCVSpline *spline = dynamic_cast<const GCVSpline*>(&get(i));
+        if(spline!=NULL)
+            rValues[i] = spline->evaluate(aDerivOrder,aX,interval);
+        else
+            rValues[i] = FunctionSet::evaluate(i,aDerivOrder,aX);
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Evaluate all the splines in the set and their first and second
+ * derivatives, sharing the knot interval as above.
+ *
+ * @param rValues Array containing the values of the functions.
+ * @param rFirstDerivatives Array containing the first derivatives.
+ * @param rSecondDerivatives Array containing the second derivatives.
+ * @param aX Value of the x independent variable.
+ */
+void GCVSplineSet::
+evaluate(Array<double> &rValues,Array<double> &rFirstDerivatives,
+         Array<double> &rSecondDerivatives,double aX) const
+{
+    int size = getSize();
+    rValues.setSize(size);
+    rFirstDerivatives.setSize(size);
+    rSecondDerivatives.setSize(size);
+
+    int interval = 0;
+    for(int i=0;i<size;i++) {
+        const GCVSpline *spline = dynamic_cast<const GCVSpline*>(&get(i));
+        if(spline!=NULL) {
+            rValues[i] = spline->evaluate(0,aX,interval);
+            rFirstDerivatives[i] = spline->evaluate(1,aX,interval);
+            rSecondDerivatives[i] = spline->evaluate(2,aX,interval);
+        } else {
+            rValues[i] = FunctionSet::evaluate(i,0,aX);
+            rFirstDerivatives[i] = FunctionSet::evaluate(i,1,aX);
+            rSecondDerivatives[i] = FunctionSet::evaluate(i,2,aX);
+        }
+    }
+}
+
 
 //=============================================================================
 // UTILITY
@@ -62,12 +62,14 @@ public:
     //--------------------------------------------------------------------------
     GCVSplineSet();
     GCVSplineSet(const char *aFileName);
-    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0);
+    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0,
+        int aNumThreads=1);
     virtual ~GCVSplineSet();
 
 private:
     void setNull();
-    void construct(int aDegree,const Storage *aStore,double aErrorVariance);
+    void construct(int aDegree,const Storage *aStore,double aErrorVariance,
+        int aNumThreads);
 
     //--------------------------------------------------------------------------
     // SET AND GET
@@ -77,6 +79,17 @@ public:
     double getMinX() const;
     double getMaxX() const;
 
+    //--------------------------------------------------------------------------
+    // EVALUATION
+    //--------------------------------------------------------------------------
+    // The splines of a set usually share their knots, so the knot interval
+    // found for one spline is where the search begins for the next.
+    using FunctionSet::evaluate;
+    void evaluate(Array<double> &rValues,int aDerivOrder,
+        double aX=0.0) const override;
+    void evaluate(Array<double> &rValues,Array<double> &rFirstDerivatives,
+        Array<double> &rSecondDerivatives,double aX=0.0) const override;
+
     //--------------------------------------------------------------------------
     // UTILITY
     //--------------------------------------------------------------------------
@@ -31,7 +31,10 @@
 #include <time.h>
 #include <math.h>
 #include <string>
+#include <cstring>
 #include <climits>
+#include <clocale>
+#include <cmath>
 
 #include "IO.h"
 #if defined(__linux__) || defined(__APPLE__)
@@ -298,6 +301,87 @@ ConstructDoubleOutputFormat()
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Construct a formatter for the current output format for doubles.
+ */
+IO::DoubleFormatter::
+DoubleFormatter() :
+    _format(_DoubleFormat),
+    _width(_Pad<0 ? 0 : _Pad+_Precision),
+    _precision(_Precision),
+    _fixed(!_GFormatForDoubleOutput && !_Scientific)
+{
+    // Integer digit generation handles up to 15 decimal places (10^15 is
+    // exact) and only the '.' decimal point.
+    if(_precision<0 || _precision>15) _fixed = false;
+    const struct lconv *lc = localeconv();
+    if(lc==NULL || lc->decimal_point==NULL || strcmp(lc->decimal_point,".")!=0)
+        _fixed = false;
+}
+//_____________________________________________________________________________
+/**
+ * Append a formatted double to a buffer.
+ */
+void IO::DoubleFormatter::
+append(std::string &rBuffer,double aValue) const
+{
+    static const double POW10[] = { 1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,
+        1e9,1e10,1e11,1e12,1e13,1e14,1e15 };
+
+    if(_fixed) {
+        // y = |aValue|*10^precision carries a relative error of at most one
+        // rounding; unless its fraction is within that error of one half,
+        // it rounds to the same integer as the exact product does.
+        double y = std::fabs(aValue)*POW10[_precision];
+        if(y<4503599627370496.0) {  // 2^52; false for NaN
+            double r0 = std::floor(y);
+            double f = y-r0;
+            double tol = y*4.440892098500626e-16+4.9406564584124654e-324;
+            if(std::fabs(f-0.5)>tol) {
+                unsigned long long r = (unsigned long long)r0 + (f>0.5 ? 1 : 0);
+                char digits[40];
+                char *end = digits+sizeof(digits);
+                char *p = end;
+                for(int i=0;i<_precision;i++) { *--p = (char)('0'+r%10); r/=10; }
+                if(_precision>0) *--p = '.';
+                do { *--p = (char)('0'+r%10); r/=10; } while(r>0);
+                if(std::signbit(aValue)) *--p = '-';
+                int n = (int)(end-p);
+                if(n<_width) rBuffer.append(_width-n,' ');
+                rBuffer.append(p,n);
+                return;
+            }
+        }
+    }
+
+    char buffer[64];
+    int n = snprintf(buffer,sizeof(buffer),_format.c_str(),aValue);
+    if(n<0) return;
+    if(n<(int)sizeof(buffer)) {
+        rBuffer.append(buffer,n);
+    } else {
+        std::string large(n+1,'\0');
+        snprintf(&large[0],large.size(),_format.c_str(),aValue);
+        rBuffer.append(large.c_str(),n);
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Append a row of a storage file, that is, a time followed by states, each
+ * preceded by a tab, and a newline, to a buffer.
+ */
+void IO::DoubleFormatter::
+appendRow(std::string &rBuffer,double aT,int aN,const double *aY) const
+{
+    append(rBuffer,aT);
+    for(int i=0;i<aN;i++) {
+        rBuffer += '\t';
+        append(rBuffer,aY[i]);
+    }
+    rBuffer += '\n';
+}
+
 //=============================================================================
 // Object printing
 //=============================================================================
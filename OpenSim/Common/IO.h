@@ -31,6 +31,7 @@
 // INCLUDES
 #include "osimCommonDLL.h"
 #include <fstream>
+#include <string>
 
 // DEFINES
 const int IO_STRLEN = 2048;
@@ -87,6 +88,36 @@ public:
 private:
     static void ConstructDoubleOutputFormat();
 
+public:
+#ifndef SWIG
+    /**
+     * A class for formatting doubles into a buffer exactly as fprintf()
+     * does with the format returned by GetDoubleOutputFormat() at the time
+     * the formatter is constructed.
+     *
+     * For the default fixed-point format, values are rounded and their
+     * digits generated with integer arithmetic, which is several times
+     * faster than fprintf().  Values whose rounding cannot be decided that
+     * way, very large values, non-finite values, the scientific and %g
+     * formats, and locales whose decimal point is not '.' fall back to
+     * snprintf().  The output is the same either way.
+     *
+     * A formatter may be used concurrently by several threads.
+     */
+    class OSIMCOMMON_API DoubleFormatter {
+    public:
+        DoubleFormatter();
+        void append(std::string &rBuffer,double aValue) const;
+        void appendRow(std::string &rBuffer,double aT,int aN,
+            const double *aY) const;
+    private:
+        std::string _format;
+        int _width;
+        int _precision;
+        bool _fixed;
+    };
+#endif
+
 public:
     // Object printing
     static void SetPrintOfflineDocuments(bool aTrueFalse);
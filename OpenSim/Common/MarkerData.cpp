@@ -91,6 +91,40 @@ MarkerData::MarkerData(const string& aFileName) :
     cout << "Loaded marker file " << _fileName << " (" << _numMarkers << " markers, " << _numFrames << " frames)" << endl;
 }
 
+//_____________________________________________________________________________
+/**
+ * Constructor from a range of the frames of another MarkerData.
+ *
+ * @param aMarkerData MarkerData from which to copy the frames.
+ * @param aStartFrame Index of the first frame to copy.
+ * @param aEndFrame Index of the last frame to copy.
+ */
+MarkerData::MarkerData(const MarkerData& aMarkerData, int aStartFrame, int aEndFrame) :
+    Object(aMarkerData),
+    _numFrames(0),
+    _numMarkers(aMarkerData._numMarkers),
+    _firstFrameNumber(aMarkerData._firstFrameNumber),
+    _dataRate(aMarkerData._dataRate),
+    _cameraRate(aMarkerData._cameraRate),
+    _originalDataRate(aMarkerData._originalDataRate),
+    _originalStartFrame(aMarkerData._originalStartFrame),
+    _originalNumFrames(aMarkerData._originalNumFrames),
+    _fileName(aMarkerData._fileName),
+    _units(aMarkerData._units),
+    _markerNames(aMarkerData._markerNames)
+{
+    if (aStartFrame < 0)
+        aStartFrame = 0;
+    if (aEndFrame >= aMarkerData._numFrames)
+        aEndFrame = aMarkerData._numFrames - 1;
+
+    for (int i = aStartFrame; i <= aEndFrame; i++)
+        _frames.append(new MarkerFrame(aMarkerData.getFrame(i)));
+    _numFrames = _frames.getSize();
+    if (_numFrames > 0)
+        _firstFrameNumber = _frames[0]->getFrameNumber();
+}
+
 //_____________________________________________________________________________
 /**
  * Destructor.
@@ -151,7 +185,10 @@ void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
             break;
         }
 
-      if (!readIntegerFromString(line, &frameNum))
+      // Read the line in place rather than erasing what has been read from
+      // its front, which made reading a frame quadratic in its length.
+      string::size_type pos = 0;
+      if (!readIntegerFromString(line, pos, &frameNum))
       {
 #if 0
          if (gUseGlobalMessages)
@@ -161,7 +198,7 @@ void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
 #endif
       }
 
-      if (!readDoubleFromString(line, &time))
+      if (!readDoubleFromString(line, pos, &time))
       {
 #if 0
          if (gUseGlobalMessages)
@@ -179,7 +216,7 @@ void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
        */
       coordsRead = 0;
       bool allowNaNs = true;
-      while (readCoordinatesFromString(line, &coords[0], allowNaNs))
+      while (readCoordinatesFromString(line, pos, &coords[0], allowNaNs))
       {
          if (coordsRead >= aSMD._numMarkers)
          {
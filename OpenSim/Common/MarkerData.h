@@ -73,6 +73,7 @@ private:
 public:
     MarkerData();
     explicit MarkerData(const std::string& aFileName) SWIG_DECLARE_EXCEPTION;
+    MarkerData(const MarkerData& aMarkerData, int aStartFrame, int aEndFrame);
     virtual ~MarkerData();
 
     void findFrameRange(double aStartTime, double aEndTime, int& rStartFrame, int& rEndFrame) const;
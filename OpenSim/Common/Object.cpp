@@ -205,6 +205,7 @@ Object& Object::
 operator=(const Object& source)
 {
     if (&source != this) {
+        if (_setNameChanges && _name != source._name) ++*_setNameChanges;
         _name           = source._name;
         _description    = source._description;
         _authors        = source._authors;
@@ -327,6 +328,7 @@ operator<(const Object& other) const
 void Object::
 setName(const string &aName)
 {
+    if (_setNameChanges && aName != _name) ++*_setNameChanges;
     _name = aName;
 }
 //_____________________________________________________________________________
@@ -44,6 +44,10 @@
 #include <cstring>
 #include <cassert>
 #include <map>
+#ifndef SWIG
+#include <memory>
+#include <atomic>
+#endif
 
 // DISABLES MULTIPLE INSTANTIATION WARNINGS
 
@@ -81,6 +85,7 @@ namespace OpenSim {
 const char ObjectDEFAULT_NAME[] = "default";
 
 class XMLDocument;
+template<class T> class Set;
 
 //==============================================================================
 //                                 OBJECT
@@ -831,6 +836,12 @@ private:
 
     // The name of this object.
     std::string     _name;
+#ifndef SWIG
+    // Count of the renames of the objects of the Set that owns this object,
+    // if that Set has indexed it by name. Incremented when the name changes.
+    std::shared_ptr<std::atomic<unsigned int> > _setNameChanges;
+    template<class T> friend class Set;
+#endif
     // A short description of the object.
     std::string     _description;
 
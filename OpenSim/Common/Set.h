@@ -34,6 +34,12 @@
 #include "ArrayPtrs.h"
 #include "ObjectGroup.h"
 #include "PropertyObjArray.h"
+#ifndef SWIG
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#endif
 
 namespace OpenSim { 
 
@@ -66,6 +72,31 @@ PropertyObjArray<ObjectGroup> _propObjectGroups;
 ArrayPtrs<T> &_objects;
 ArrayPtrs<ObjectGroup> &_objectGroups;
 
+#ifndef SWIG
+private:
+// NAME INDEX
+/** Sets with fewer objects than this are searched by name directly. */
+static const int MIN_SIZE_FOR_NAME_INDEX = 8;
+/** Index of the first object with each name, and the state of the set it
+was built from. */
+struct NameIndex {
+    std::unordered_map<std::string,int> indices;
+    unsigned int modificationCount;
+    unsigned int nameChanges;
+};
+/** Index of the names of the objects, built when needed by getIndex() for
+sets that own their objects.  It is replaced whenever _objects has been
+modified or one of its objects has been renamed since it was built.  An
+index, once published, is never changed, so lookups read it without
+locking. */
+mutable std::shared_ptr<const NameIndex> _nameIndex;
+/** Number of renames of the objects of this set since they were indexed.
+Each indexed object shares it and increments it when its name changes. */
+std::shared_ptr<std::atomic<unsigned int> > _nameChanges;
+/** Serializes the building of _nameIndex by const methods. */
+mutable std::mutex _nameIndexMutex;
+#endif
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -139,6 +170,8 @@ setNull()
     setupProperties();
     _objects.setSize(0);
     _objectGroups.setSize(0);
+    _nameIndex.reset();
+    _nameChanges.reset(new std::atomic<unsigned int>(0));
 }
 //_____________________________________________________________________________
 /**
@@ -153,6 +186,19 @@ setupProperties()
     _propObjectGroups.setName("groups");
     _propertySet.append(    &_propObjectGroups );
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Whether a name index was built from the objects as they are now.
+ */
+bool
+isCurrent(const std::shared_ptr<const NameIndex> &aIndex) const
+{
+    return( aIndex &&
+        aIndex->modificationCount==_objects.getModificationCount() &&
+        aIndex->nameChanges==*_nameChanges );
+}
+#endif
 
 public:
 //_____________________________________________________________________________
@@ -439,7 +485,34 @@ virtual int getIndex(const T *aObject,int aStartIndex=0) const
  */
 virtual int getIndex(const std::string &aName,int aStartIndex=0) const
 {
-    return( _objects.getIndex(aName,aStartIndex) );
+    // Objects owned elsewhere report their renames to their owner only.
+    int size = _objects.getSize();
+    if((aStartIndex>0 && aStartIndex<size) || size<MIN_SIZE_FOR_NAME_INDEX ||
+        !_objects.getMemoryOwner())
+        return( _objects.getIndex(aName,aStartIndex) );
+
+    std::shared_ptr<const NameIndex> index = std::atomic_load(&_nameIndex);
+    if(!isCurrent(index)) {
+        std::lock_guard<std::mutex> lock(_nameIndexMutex);
+        index = std::atomic_load(&_nameIndex);
+        if(!isCurrent(index)) {
+            std::shared_ptr<NameIndex> built(new NameIndex);
+            built->modificationCount = _objects.getModificationCount();
+            built->nameChanges = *_nameChanges;
+            built->indices.reserve(size);
+            // insert() keeps the first object with a name.
+            for(int i=0;i<size;i++) {
+                Object* object = _objects[i];
+                object->_setNameChanges = _nameChanges;
+                built->indices.insert(std::make_pair(_objects[i]->getName(),i));
+            }
+            index = built;
+            std::atomic_store(&_nameIndex, index);
+        }
+    }
+    std::unordered_map<std::string,int>::const_iterator it =
+        index->indices.find(aName);
+    return( it==index->indices.end() ? -1 : it->second );
 }
 //_____________________________________________________________________________
 /**
@@ -668,12 +741,16 @@ virtual T& get(int aIndex) const
  */
 T& get(const std::string &aName)
 {
-    return( *_objects.get(aName) );
+    int index = getIndex(aName);
+    if(index==-1) return( *_objects.get(aName) );  // throws
+    return( *_objects[index] );
 }
 #ifndef SWIG
 const T& get(const std::string &aName) const
 {
-    return( *_objects.get(aName) );
+    int index = getIndex(aName);
+    if(index==-1) return( *_objects.get(aName) );  // throws
+    return( *_objects[index] );
 }
 #endif
 //_____________________________________________________________________________
@@ -685,7 +762,7 @@ const T& get(const std::string &aName) const
  */
 bool contains(const std::string &aName) const
 {
-    return( _objects.getIndex(aName) != -1 );
+    return( getIndex(aName) != -1 );
 }//_____________________________________________________________________________
 /**
  * Get names of objects in the set.
@@ -211,35 +211,46 @@ bool OpenSim::readTabDelimitedStringFromString(string &aString, string &rBuffer)
  */
 bool OpenSim::readIntegerFromString(string &aString, int *rNumber)
 {
-   size_t i, end;
+   string::size_type pos = 0;
+   bool ok = OpenSim::readIntegerFromString(aString, pos, rNumber);
+   aString.erase(0, pos);
+   return ok;
+}
+
+//_____________________________________________________________________________
+/**
+ * Read an integer from an input string, starting at a specified position.
+ * The position is advanced past the integer (and any whitespace after it),
+ * exactly as readIntegerFromString(string&, int*) would erase them, so a
+ * whole line can be read without repeatedly copying what remains of it.
+ *
+ * @param aString input string to read from.
+ * @param rPos position at which to start reading; advanced on return.
+ * @param rNumber integer that is read is returned here.
+ * @return True if integer was read, false if not.
+ */
+bool OpenSim::readIntegerFromString(const string &aString, string::size_type &rPos, int *rNumber)
+{
+   string::size_type i, end = aString.length();
    string buffer;
 
-   if (aString.empty())
+   if (rPos >= end)
       return false;
 
-   /* remove any characters before the number */
-   i = aString.find_first_of("0123456789-", 0);
-   if (i != 0)
-      aString.erase(0, i);
+   /* skip any characters before the number */
+   i = aString.find_first_of("0123456789-", rPos);
+   rPos = (i != aString.npos) ? i : end;
 
-   /* remove number from string, copy number to buffer */
-   i = aString.find_first_not_of("0123456789-eE", 0);
-   end = aString.length();
-   if (i != aString.npos)
-   {
-      buffer.assign(aString, 0, i);
-      aString.erase(0, i);
-   }
-   else
-   {
-      buffer.assign(aString);
-      aString.erase(0, end);
-   }
+   /* copy number to buffer */
+   i = aString.find_first_not_of("0123456789-eE", rPos);
+   if (i == aString.npos)
+      i = end;
+   buffer.assign(aString, rPos, i - rPos);
+   rPos = i;
 
-   /* remove any whitespace after the string*/
-   i = findFirstNonWhiteSpace(aString);
-   if (i > 0)
-      aString.erase(0, i);
+   /* skip any whitespace after the string*/
+   i = aString.find_first_not_of(" \t\r\n", rPos);
+   rPos = (i != aString.npos) ? i : end;
    
    if (buffer.empty())
       return false;
@@ -247,7 +258,6 @@ bool OpenSim::readIntegerFromString(string &aString, int *rNumber)
    return true;
 }
 
-
 //_____________________________________________________________________________
 /**
  * Read a double from an input string. The input string is
@@ -259,46 +269,57 @@ bool OpenSim::readIntegerFromString(string &aString, int *rNumber)
  */
 bool OpenSim::readDoubleFromString(string &aString, double *rNumber, bool allowNaNs)
 {
-   size_t i, end;
+   string::size_type pos = 0;
+   bool ok = OpenSim::readDoubleFromString(aString, pos, rNumber, allowNaNs);
+   aString.erase(0, pos);
+   return ok;
+}
+
+//_____________________________________________________________________________
+/**
+ * Read a double from an input string, starting at a specified position.
+ * The position is advanced past the double, exactly as
+ * readDoubleFromString(string&, double*, bool) would erase it.
+ *
+ * @param aString input string to read from.
+ * @param rPos position at which to start reading; advanced on return.
+ * @param rNumber double that is read is returned here.
+ * @return True if double was read, false if not.
+ */
+bool OpenSim::readDoubleFromString(const string &aString, string::size_type &rPos, double *rNumber, bool allowNaNs)
+{
+   string::size_type i, end = aString.length();
    string buffer;
 
-   if (aString.empty())
+   if (rPos >= end)
       return false;
-   // Remove leading spaces
-    while(aString[0]==' ') aString.erase(0, 1);
-   /* remove any characters before the number */
-   i = aString.find_first_of("0123456789-.", 0);
-   if (i != 0){
+   // Skip leading spaces
+   while(rPos < end && aString[rPos]==' ') rPos++;
+   /* skip any characters before the number */
+   i = aString.find_first_of("0123456789-.", rPos);
+   if (i != rPos){
        if (allowNaNs){
            std::string NaNString = "NAN";
-           std::string prefix = aString.substr(0, 3);
+           std::string prefix = aString.substr(rPos, 3);
            std::transform(prefix.begin(), prefix.end(),prefix.begin(), ::toupper);
            if (prefix==NaNString){
-                aString.erase(0, 3);
+                rPos += 3;
                 *rNumber = SimTK::NaN;
                 return true;
            }
        }
-      aString.erase(0, i);
-   }
-   /* remove number from string, copy number to buffer */
-   i = aString.find_first_not_of("0123456789-+.eE", 0);
-   end = aString.length();
-   if (i != aString.npos)
-   {
-      buffer.assign(aString, 0, i);
-      aString.erase(0, i);
-   }
-   //if number is at end of string
-   else
-   {
-      buffer.assign(aString);
-      aString.erase(0, end);
+      rPos = (i != aString.npos) ? i : end;
    }
-   /* remove any whitespace after the string, but don't remove any tabs */
-   i = findFirstNonWhiteSpace(aString);
-   if (i != aString.npos && (i > 0) && (aString[i-1] != '\t'))
-      aString.erase(0, i);
+   /* copy number to buffer */
+   i = aString.find_first_not_of("0123456789-+.eE", rPos);
+   if (i == aString.npos)
+      i = end;
+   buffer.assign(aString, rPos, i - rPos);
+   rPos = i;
+   /* skip any whitespace after the string, but don't skip any tabs */
+   i = aString.find_first_not_of(" \t\r\n", rPos);
+   if (i != aString.npos && (i > rPos) && (aString[i-1] != '\t'))
+      rPos = i;
 
    if (buffer.empty())
       return false;
@@ -359,20 +380,40 @@ bool OpenSim::readVectorFromString(string &aString, double *rVX, double *rVY, do
  * @return True if coordinates were read, false if not.
  */
 bool OpenSim::readCoordinatesFromString(string &aString, double rVec[3], bool allowNaNs)
+{
+   string::size_type pos = 0;
+   bool ok = OpenSim::readCoordinatesFromString(aString, pos, rVec, allowNaNs);
+   aString.erase(0, pos);
+   return ok;
+}
+
+//_____________________________________________________________________________
+/**
+ * Read tab-delimited XYZ coordinate values from a string, starting at a
+ * specified position. The position is advanced past the coordinates,
+ * exactly as readCoordinatesFromString(string&, double[3], bool) would
+ * erase them.
+ *
+ * @param aString input string to read from.
+ * @param rPos position at which to start reading; advanced on return.
+ * @param rVec vector of coordinates is returned here.
+ * @return True if coordinates were read, false if not.
+ */
+bool OpenSim::readCoordinatesFromString(const string &aString, string::size_type &rPos, double rVec[3], bool allowNaNs)
 {
    int numTabs = 0, numCoords = 0;
    double value;
 
-   while (!aString.empty())
+   while (rPos < aString.length())
    {
-      if (aString[0] == '\t')
+      if (aString[rPos] == '\t')
       {
          numTabs++;
-         aString.erase(0, 1);
+         rPos++;
       }
       else
       {
-         if (!OpenSim::readDoubleFromString(aString, &value, allowNaNs))
+         if (!OpenSim::readDoubleFromString(aString, rPos, &value, allowNaNs))
          {
             return false;
          }
@@ -41,6 +41,11 @@ bool OSIMCOMMON_API readDoubleFromString(std::string &aString, double *rNumber,
 bool OSIMCOMMON_API readVectorFromString(std::string &aString, SimTK::Vec3 &rVec);
 bool OSIMCOMMON_API readVectorFromString(std::string &aString, double *rVX, double *rVY, double *rVZ);
 bool OSIMCOMMON_API readCoordinatesFromString(std::string &aString, double rVec[3], bool allowNaNs=false);
+// Variants of the above that leave the string intact and instead advance
+// rPos past what was read.
+bool OSIMCOMMON_API readIntegerFromString(const std::string &aString, std::string::size_type &rPos, int *rNumber);
+bool OSIMCOMMON_API readDoubleFromString(const std::string &aString, std::string::size_type &rPos, double *rNumber, bool allowNaNs=false);
+bool OSIMCOMMON_API readCoordinatesFromString(const std::string &aString, std::string::size_type &rPos, double rVec[3], bool allowNaNs=false);
 int OSIMCOMMON_API findFirstNonWhiteSpace(std::string &aString);
 int OSIMCOMMON_API findFirstWhiteSpace(std::string &aString);
 void OSIMCOMMON_API convertString(std::string& aString, bool aPrependUnderscore);
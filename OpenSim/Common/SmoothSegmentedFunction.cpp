@@ -37,6 +37,7 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+static int MAX_TABLE_INTERVALS = 65536;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -93,7 +94,8 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _tableError(SimTK::NaN)
 {
     
 
@@ -164,7 +166,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _tableError(SimTK::NaN)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -198,7 +201,10 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_tableCoefficients.empty())
+    {
+        yVal = calcTableValue(x,0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -267,7 +273,10 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(x >= _x0 && x <= _x1 && order <= 2 
+                && !_tableCoefficients.empty()){
+                yVal = calcTableValue(x,order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -429,6 +438,203 @@ SimTK::Vec2 SmoothSegmentedFunction::getCurveDomain() const
     return xrange;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Tabulation
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ Evaluates y, dy/dx and d2y/dx2 of a Bezier section exactly.
+*/
+static SimTK::Vec3 calcBezierSectionDerivatives(double x, 
+                    const SimTK::Vector& mX, const SimTK::Vector& mY,
+                    const SimTK::Spline& splineUX)
+{
+    double u = SegmentedQuinticBezierToolkit::
+                    calcU(x, mX, splineUX, UTOL, MAXITER);
+    return SimTK::Vec3(
+        SegmentedQuinticBezierToolkit::calcQuinticBezierCurveVal(u, mY),
+        SegmentedQuinticBezierToolkit::
+            calcQuinticBezierCurveDerivDYDX(u, mX, mY, 1),
+        SegmentedQuinticBezierToolkit::
+            calcQuinticBezierCurveDerivDYDX(u, mX, mY, 2));
+}
+
+/*
+ Each interval is mapped onto t in [0,1]. With h the width of the interval,
+ the quintic that matches y, h*dy/dx and h^2*d2y/dx2 at both ends of the
+ interval has the coefficients below, where
+
+    D0 = y1 - y0 - h*dydx0 - h^2*d2ydx20/2
+    D1 = h*(dydx1 - dydx0) - h^2*d2ydx20
+    D2 = h^2*(d2ydx21 - d2ydx20)
+
+ are the parts of the end conditions at t=1 not met by the first three terms.
+*/
+void SmoothSegmentedFunction::buildTable(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS( tolerance > 0,
+        "SmoothSegmentedFunction::buildTable",
+        "%s: tolerance must be greater than 0, but was %f",
+        _name.c_str(), tolerance);
+
+    std::vector<double> coefficients;
+    SimTK::Array_<double> xStart, xEnd, scale;
+    SimTK::Array_<int> intervals, offset;
+    SimTK::Vec3 maxError(0);
+
+    for(int s=0; s < _numBezierSections; s++){
+        const SimTK::Vector& mX = _mXVec[s];
+        const SimTK::Vector& mY = _mYVec[s];
+        const double xs = mX(0);
+        const double xe = mX(mX.size()-1);
+
+        std::vector<double> c;
+        SimTK::Vec3 sectionError;
+        int n = 8;
+        while(true){
+            const double h = (xe-xs)/n;
+            c.resize(6*n);
+
+            //Sample the exact curve at the nodes and fit each interval
+            SimTK::Vec3 magnitude(1.0);
+            SimTK::Vec3 a = calcBezierSectionDerivatives(xs,mX,mY,
+                                                    _arraySplineUX[s]);
+            for(int k=0; k<3; k++)
+                magnitude[k] = max(magnitude[k], fabs(a[k]));
+            for(int i=0; i<n; i++){
+                double x = (i+1 == n) ? xe : xs + (i+1)*h;
+                SimTK::Vec3 b = calcBezierSectionDerivatives(x,mX,mY,
+                                                    _arraySplineUX[s]);
+                for(int k=0; k<3; k++)
+                    magnitude[k] = max(magnitude[k], fabs(b[k]));
+
+                double D0 = b[0] - a[0] - h*a[1] - 0.5*h*h*a[2];
+                double D1 = h*(b[1] - a[1]) - h*h*a[2];
+                double D2 = h*h*(b[2] - a[2]);
+                double* ci = &c[6*i];
+                ci[0] = a[0];
+                ci[1] = h*a[1];
+                ci[2] = 0.5*h*h*a[2];
+                ci[3] =  10*D0 - 4*D1 + 0.5*D2;
+                ci[4] = -15*D0 + 7*D1 -     D2;
+                ci[5] =   6*D0 - 3*D1 + 0.5*D2;
+                a = b;
+            }
+
+            //Measure the error inside each interval
+            sectionError = SimTK::Vec3(0);
+            for(int i=0; i<n; i++){
+                const double* ci = &c[6*i];
+                for(int j=1; j<4; j++){
+                    double t = 0.25*j;
+                    SimTK::Vec3 exact = calcBezierSectionDerivatives(
+                                xs + (i+t)*h, mX, mY, _arraySplineUX[s]);
+                    double y = ci[0]+t*(ci[1]+t*(ci[2]+t*(ci[3]
+                                +t*(ci[4]+t*ci[5]))));
+                    double dydx = (ci[1]+t*(2*ci[2]+t*(3*ci[3]
+                                +t*(4*ci[4]+t*5*ci[5]))))/h;
+                    double d2ydx2 = (2*ci[2]+t*(6*ci[3]
+                                +t*(12*ci[4]+t*20*ci[5])))/(h*h);
+                    sectionError[0] = max(sectionError[0],fabs(y-exact[0]));
+                    sectionError[1] = max(sectionError[1],fabs(dydx-exact[1]));
+                    sectionError[2] = max(sectionError[2],
+                                          fabs(d2ydx2-exact[2]));
+                }
+            }
+
+            bool converged = true;
+            for(int k=0; k<3; k++)
+                converged = converged 
+                            && sectionError[k] <= tolerance*magnitude[k];
+            if(converged)
+                break;
+
+            SimTK_ERRCHK2_ALWAYS( 2*n <= MAX_TABLE_INTERVALS,
+                "SmoothSegmentedFunction::buildTable",
+                "%s: a tolerance of %e could not be met by the table",
+                _name.c_str(), tolerance);
+            n *= 2;
+        }
+
+        xStart.push_back(xs);
+        xEnd.push_back(xe);
+        scale.push_back(n/(xe-xs));
+        intervals.push_back(n);
+        offset.push_back((int)coefficients.size()/6);
+        coefficients.insert(coefficients.end(), c.begin(), c.end());
+        for(int k=0; k<3; k++)
+            maxError[k] = max(maxError[k], sectionError[k]);
+    }
+
+    _tableCoefficients = coefficients;
+    _tableXStart = xStart;
+    _tableXEnd   = xEnd;
+    _tableScale  = scale;
+    _tableIntervals = intervals;
+    _tableOffset = offset;
+    _tableError  = maxError;
+}
+
+void SmoothSegmentedFunction::clearTable()
+{
+    _tableCoefficients.clear();
+    _tableXStart.clear();
+    _tableXEnd.clear();
+    _tableScale.clear();
+    _tableIntervals.clear();
+    _tableOffset.clear();
+    _tableError = SimTK::Vec3(SimTK::NaN);
+}
+
+bool SmoothSegmentedFunction::isTabulated() const
+{
+    return !_tableCoefficients.empty();
+}
+
+double SmoothSegmentedFunction::getTableError(int order) const
+{
+    SimTK_ERRCHK2_ALWAYS( order >= 0 && order <= 2,
+        "SmoothSegmentedFunction::getTableError",
+        "%s: order must be between 0 and 2, but was %i",
+        _name.c_str(), order);
+    return _tableError[order];
+}
+
+/*Detailed Computational Costs
+________________________________________________________________________
+                        Name     Comp.   Div.    Mult.   Add.    Assign.
+_______________________________________________________________________
+              section search    2*m
+             interval lookup      2               2       2       3
+       Horner (order 0 to 2)                  5 to 9  3 to 5      1
+________________________________________________________________________
+*/
+double SmoothSegmentedFunction::calcTableValue(double x, int order) const
+{
+    int s = 0;
+    while(s < _numBezierSections-1 && x > _tableXEnd[s])
+        s++;
+
+    const double scale = _tableScale[s];
+    double t = (x - _tableXStart[s])*scale;
+    int i = (int)t;
+    if(i < 0)
+        i = 0;
+    else if(i >= _tableIntervals[s])
+        i = _tableIntervals[s]-1;
+    t -= i;
+
+    const double* c = &_tableCoefficients[6*(_tableOffset[s]+i)];
+    switch(order){
+        case 0:
+            return c[0]+t*(c[1]+t*(c[2]+t*(c[3]+t*(c[4]+t*c[5]))));
+        case 1:
+            return (c[1]+t*(2*c[2]+t*(3*c[3]+t*(4*c[4]+t*5*c[5]))))*scale;
+        default:
+            return (2*c[2]+t*(6*c[3]+t*(12*c[4]+t*20*c[5])))*scale*scale;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Utility functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,7 @@
 
 //#include "SmoothSegmentedFunctionFactory.h"
 #include "SegmentedQuinticBezierToolkit.h"
+#include <vector>
 
 namespace OpenSim { 
 
@@ -85,12 +86,13 @@ namespace OpenSim {
        The curve is parameterized as a set of Bezier curves. If x is within the
        domain of these Bezier curves they will be evaluated. If x is outside
        of the domain of these Bezier curves a linear extrapolation will be 
-       evalulated
+       evalulated. If buildTable() has been called, the Bezier curves are
+       replaced by the table within the curve domain.
 
 
        <B>Computational Costs</B>
        \verbatim
-            x in curve domain  : ~282 flops
+            x in curve domain  : ~282 flops (~20 flops if tabulated)
             x in linear section:   ~5 flops
        \endverbatim
        */
@@ -191,6 +193,49 @@ namespace OpenSim {
                   derivative) linear extrapolation*/
        SimTK::Vec2 getCurveDomain() const;
 
+       /**Replaces the evaluation of the curve within its domain by a table of
+       piecewise quintic polynomials. Each Bezier section is divided into
+       equal intervals in x, and on each interval the polynomial matches the
+       value, slope and curvature of the curve at both ends. The number of 
+       intervals is doubled until, on every interval, the value and the first
+       two derivatives of the table agree with the exact curve to within
+
+       \verbatim
+            tolerance*max(1, largest magnitude of that derivative on the section)
+       \endverbatim
+
+       at the quarter, half and three quarter points of the interval, where the
+       error of the interpolant is largest. The errors found are available from
+       getTableError(). Derivatives of order 3 and higher, the linear 
+       extrapolation and the integral are still computed exactly.
+
+       @param tolerance The relative accuracy required of the table
+       @throws SimTK::Exception
+        -If tolerance is not positive
+        -If the tolerance cannot be met with 65536 intervals per section
+
+       <B>Computational Costs</B>
+       \verbatim
+            building the table   : ~(number of intervals)*4*400 flops
+            x in curve domain    : ~20 to 35 flops, for orders 0 to 2
+       \endverbatim
+       */
+       void buildTable(double tolerance);
+
+       /**Discards the table built by buildTable(), so that the curve is once
+       again evaluated exactly.*/
+       void clearTable();
+
+       /**@return true if buildTable() has been called and the curve is being
+       evaluated from its table*/
+       bool isTabulated() const;
+
+       /**@param order The order of the derivative, between 0 and 2
+       @return The largest absolute error between the table and the exact 
+               curve in the derivative of the given order that was found when
+               the table was built, or NaN if the curve is not tabulated*/
+       double getTableError(int order) const;
+
        /**This function will generate a csv file (of 'name_curveName.csv', where 
        name is the one used in the constructor) of the muscle curve, and 
        'curveName' corresponds to the function that was called from
@@ -338,6 +383,28 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**Coefficients of the quintic polynomial of each table interval, six
+        per interval in increasing powers of the position t (0 to 1) within 
+        the interval. Empty unless buildTable() has been called*/
+        std::vector<double> _tableCoefficients;
+        /**The x at which the table of each Bezier section ends*/
+        SimTK::Array_<double> _tableXEnd;
+        /**The x at which the table of each Bezier section starts*/
+        SimTK::Array_<double> _tableXStart;
+        /**The number of intervals per unit x in each Bezier section*/
+        SimTK::Array_<double> _tableScale;
+        /**The number of intervals in each Bezier section*/
+        SimTK::Array_<int> _tableIntervals;
+        /**The index of the first interval of each Bezier section*/
+        SimTK::Array_<int> _tableOffset;
+        /**The largest errors in y, dy/dx and d2y/dx2 found by buildTable()*/
+        SimTK::Vec3 _tableError;
+
+        /**Evaluates the table at a point x within the curve domain
+        @param x     The domain point of interest
+        @param order The order of the derivative, between 0 and 2*/
+        double calcTableValue(double x, int order) const;
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
@@ -25,6 +25,8 @@
 //=============================================================================
 
 #include "SmoothSegmentedFunctionFactory.h"
+#include <map>
+#include <mutex>
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -48,6 +50,26 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e4;
 
 static int MAXITER = 20;
+
+//The curves shared by getSharedCurve, keyed by curve type and parameters. The
+//cache holds weak references so that a curve is freed with its last user.
+typedef std::pair<std::string, std::vector<double> > SharedCurveKey;
+typedef std::map<SharedCurveKey, std::weak_ptr<const SmoothSegmentedFunction> >
+    SharedCurveMap;
+
+//Function-local statics, so that curves built during static initialization
+//(e.g., type registration) find the cache constructed.
+static SharedCurveMap& updSharedCurves()
+{
+    static SharedCurveMap sharedCurves;
+    return sharedCurves;
+}
+
+static std::mutex& getSharedCurveMutex()
+{
+    static std::mutex sharedCurveMutex;
+    return sharedCurveMutex;
+}
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -57,6 +79,61 @@ double SmoothSegmentedFunctionFactory::scaleCurviness(double curviness)
     return c;
 }
 //=============================================================================
+// SHARED CURVES
+//=============================================================================
+std::shared_ptr<const SmoothSegmentedFunction> SmoothSegmentedFunctionFactory::
+    getSharedCurve(const std::string& curveType,
+                   const std::vector<double>& parameters,
+                   const std::function<SmoothSegmentedFunction*()>& createCurve)
+{
+    SharedCurveKey key(curveType, parameters);
+    {
+        std::lock_guard<std::mutex> lock(getSharedCurveMutex());
+        SharedCurveMap::iterator it = updSharedCurves().find(key);
+        if(it != updSharedCurves().end()) {
+            std::shared_ptr<const SmoothSegmentedFunction> curve = 
+                it->second.lock();
+            if(curve)
+                return curve;
+        }
+    }
+
+    //Build outside the lock so that threads building different curves do not
+    //wait on each other. If another thread shared the same curve meanwhile,
+    //its curve is used and this one is discarded.
+    std::shared_ptr<const SmoothSegmentedFunction> curve(createCurve());
+
+    std::lock_guard<std::mutex> lock(getSharedCurveMutex());
+    SharedCurveMap& sharedCurves = updSharedCurves();
+    std::weak_ptr<const SmoothSegmentedFunction>& entry = sharedCurves[key];
+    std::shared_ptr<const SmoothSegmentedFunction> existing = entry.lock();
+    if(existing)
+        return existing;
+    entry = curve;
+
+    //Forget curves that are no longer used by anyone.
+    for(SharedCurveMap::iterator it = sharedCurves.begin(); 
+        it != sharedCurves.end(); ) {
+        if(it->second.expired())
+            sharedCurves.erase(it++);
+        else
+            ++it;
+    }
+    return curve;
+}
+
+int SmoothSegmentedFunctionFactory::getNumSharedCurves()
+{
+    std::lock_guard<std::mutex> lock(getSharedCurveMutex());
+    int n = 0;
+    for(SharedCurveMap::const_iterator it = updSharedCurves().begin(); 
+        it != updSharedCurves().end(); ++it) {
+        if(!it->second.expired())
+            n++;
+    }
+    return n;
+}
+//=============================================================================
 // MUSCLE CURVE FITTING FUNCTIONS
 //=============================================================================
 SmoothSegmentedFunction* SmoothSegmentedFunctionFactory::
@@ -33,6 +33,8 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <functional>
+#include <memory>
 
 namespace OpenSim {
 
@@ -777,7 +779,48 @@ class OSIMCOMMON_API SmoothSegmentedFunctionFactory
                                         bool computeIntegral, 
                                         const std::string& curveName);
 
-        
+        /**
+        Returns a curve that is shared, read only, by every caller that asks 
+        for the same kind of curve with the same parameters. The curve is 
+        built by createCurve the first time it is asked for and is kept for as
+        long as any caller holds it, so that the muscles of a model, and the
+        clones of that model, build each distinct curve only once. This 
+        function may be called from several threads at once.
+
+        @param curveType  The kind of curve, which is usually the name of the
+                          function of this class that createCurve calls.
+        @param parameters Every value that defines the curve, including the 
+                          computeIntegral flag and the tolerance of any table
+                          the curve is evaluated from (see 
+                          SmoothSegmentedFunction::buildTable()). The name of 
+                          the curve is not one of them: a shared curve keeps 
+                          the name it was first built with.
+        @param createCurve Builds a new curve from the parameters. It is not
+                          called if the curve is already shared.
+
+        @return The shared curve
+
+        <B>Example:</B>
+        @code
+            std::shared_ptr<const SmoothSegmentedFunction> tendonCurve = 
+                SmoothSegmentedFunctionFactory::getSharedCurve(
+                    "createTendonForceLengthCurve", {e0,kiso,fToe,c,1}, [&]() {
+                        return SmoothSegmentedFunctionFactory::
+                            createTendonForceLengthCurve(
+                                e0,kiso,fToe,c,true,"test"); });
+        @endcode
+        */
+        static std::shared_ptr<const SmoothSegmentedFunction>
+            getSharedCurve(const std::string& curveType,
+                        const std::vector<double>& parameters,
+                        const std::function<SmoothSegmentedFunction*()>& 
+                            createCurve);
+
+        /**
+        @return The number of distinct curves that are currently shared by the
+        callers of getSharedCurve()
+        */
+        static int getNumSharedCurves();
 
     private:
         /**
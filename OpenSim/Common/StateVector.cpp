@@ -548,35 +548,16 @@ print(FILE *fp) const
         return(-1);
     }
 
-    // TIME
-    char format[IO_STRLEN];
-    sprintf(format,"%s",IO::GetDoubleOutputFormat());
-    int n=0,nTotal=0;
-    n = fprintf(fp,format,_t);
-    if(n<0) {
-        printf("StateVector.print(FILE*): error writing to file.\n");
-        return(n);
-    }
-    nTotal += n;
-
-    // STATES
-    sprintf(format,"\t%s",IO::GetDoubleOutputFormat());
-    for(int i=0;i<_data.getSize();i++) {
-        n = fprintf(fp,format,_data[i]);
-        if(n<0) {
-            printf("StateVector.print(FILE*): error writing to file.\n");
-            return(n);
-        }
-        nTotal += n;
-    }
+    // FORMAT THE ROW
+    std::string row;
+    IO::DoubleFormatter formatter;
+    formatter.appendRow(row,_t,_data.getSize(),_data.get());
 
-    // CARRIAGE RETURN
-    n = fprintf(fp,"\n");
-    if(n<0) {
+    // WRITE
+    if(fwrite(row.c_str(),1,row.size(),fp)!=row.size()) {
         printf("StateVector.print(FILE*): error writing to file.\n");
-        return(n);
+        return(-1);
     }
-    nTotal += n;
 
-    return(nTotal);
+    return((int)row.size());
 }
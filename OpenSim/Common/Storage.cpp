@@ -30,6 +30,10 @@
 #include "osimCommonDLL.h"
 #include <sstream>
 #include <iostream>
+#include <clocale>
+#include <limits>
+#include <locale>
+#include <thread>
 #include "IO.h"
 #include "Signal.h"
 #include "Storage.h"
@@ -55,6 +59,10 @@ using namespace std;
 const char* Storage::DEFAULT_HEADER_TOKEN = "endheader";
 const char* Storage::DEFAULT_HEADER_SEPARATOR = " \t\r\n";
 const int Storage::MAX_RESAMPLE_SIZE = 100000;
+const char* Storage::BINARY_FILE_EXTENSION = ".stob";
+// Leading characters and version of the binary file format.
+static const char BINARY_FILE_MAGIC[8] = {'O','S','I','M','S','T','O','B'};
+static const int BINARY_FILE_VERSION = 1;
 //============================================================================
 // STATICS
 //============================================================================
@@ -71,6 +79,111 @@ int numSimmReservedKeys=10; // Keep this number in sync with above array size
 // up version to 20301 for separation of RRATool, CMCTool
 const int Storage::LatestVersion = 1;   
 
+//=============================================================================
+// FILE PARSING
+//=============================================================================
+namespace {
+//_____________________________________________________________________________
+/**
+ * Reads whitespace-separated numbers from a buffer in memory, giving exactly
+ * the values, and the failure behavior, of std::istream::operator>>(double&)
+ * in the classic locale: the characters that form a number are collected
+ * and converted with strtod(); once a read fails, all later reads leave
+ * their argument unchanged.
+ */
+class StorageNumberReader {
+public:
+    StorageNumberReader(const char *aBegin,const char *aEnd) :
+        _p(aBegin),_end(aEnd),_failed(false) {}
+
+    StorageNumberReader& operator>>(double &rValue) {
+        if(_failed) return(*this);
+
+        // SKIP WHITESPACE
+        while(_p<_end && isspace((unsigned char)*_p)) _p++;
+        if(_p==_end) {
+            _failed = true;
+            return(*this);
+        }
+
+        // COLLECT [+-]digits[.digits][(e|E)[+-]digits]
+        const char *start = _p;
+        int nDigits = 0;
+        if(*_p=='+' || *_p=='-') _p++;
+        while(_p<_end && isdigit((unsigned char)*_p)) { _p++; nDigits++; }
+        if(_p<_end && *_p=='.') {
+            _p++;
+            while(_p<_end && isdigit((unsigned char)*_p)) { _p++; nDigits++; }
+        }
+        if(nDigits>0 && _p<_end && (*_p=='e' || *_p=='E')) {
+            _p++;
+            if(_p<_end && (*_p=='+' || *_p=='-')) _p++;
+            while(_p<_end && isdigit((unsigned char)*_p)) _p++;
+        }
+        if(nDigits==0) {
+            rValue = 0.0;
+            _failed = true;
+            return(*this);
+        }
+
+        // CONVERT
+        // The collected characters are copied so that strtod() cannot read
+        // past them (e.g., the x of 0x1A).  As with >>, they must all be
+        // part of the number (e.g., "1e" is an error).
+        char local[64];
+        std::string longNumber;
+        const char *number = local;
+        size_t len = _p-start;
+        if(len<sizeof(local)) {
+            memcpy(local,start,len);
+            local[len] = '\0';
+        } else {
+            longNumber.assign(start,len);
+            number = longNumber.c_str();
+        }
+        char *numberEnd;
+        rValue = strtod(number,&numberEnd);
+        if(numberEnd!=number+len) {
+            rValue = 0.0;
+            _failed = true;
+        } else if(SimTK::isInf(rValue)) {
+            rValue = (rValue>0) ? std::numeric_limits<double>::max() :
+                                 -std::numeric_limits<double>::max();
+            _failed = true;
+        }
+        return(*this);
+    }
+
+private:
+    const char *_p;
+    const char *_end;
+    bool _failed;
+};
+
+//_____________________________________________________________________________
+/**
+ * Read aNumRows rows of aNumColumns numbers from aIn and append them to
+ * rStorage.  If the data have no time column, the row number is used as
+ * the time.
+ */
+template <class Reader>
+void readRows(Reader &aIn,Storage &rStorage,int aNumRows,int aNumColumns,
+              bool aHasTime)
+{
+    int ny = aHasTime ? aNumColumns-1 : aNumColumns;
+    double time;
+    double *y = new double[ny];
+    for(int r=0;r<aNumRows;r++) {
+        if(aHasTime) aIn>>time;
+        else time=(double)r;
+        for(int i=0;i<ny;i++)
+            aIn>>y[i];
+        rStorage.append(time,ny,y);
+    }
+    delete[] y;
+}
+}
+
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
@@ -121,6 +234,12 @@ Storage::Storage(const string &aFileName, bool readHeadersOnly) :
     // SET NULL STATES
     setNull();
 
+    // BINARY FILE
+    if(isBinaryFileName(aFileName)) {
+        readBinary(aFileName,readHeadersOnly);
+        return;
+    }
+
     // OPEN FILE
     ifstream *fp = IO::OpenInputFile(aFileName);
     if(fp==NULL) throw Exception("Storage: ERROR- failed to open file " + aFileName, __FILE__,__LINE__);
@@ -163,36 +282,36 @@ Storage::Storage(const string &aFileName, bool readHeadersOnly) :
     int indexRange = currentLabels.findIndex("range");
 
 
-    // DATA 
-    if(indexTime != -1 || indexRange != -1){ //MM edit
-        int ny = nc-1;
-        double time;
-        double *y = new double[ny];
-        for(int r=0;r<nr;r++) {
-                (*fp)>>time;
-                for(int i=0;i<ny;i++)
-                    (*fp)>>y[i];
-                append(time,ny,y);
+    // DATA
+    // The rest of the file is read into memory at once and parsed with
+    // StorageNumberReader, which gives exactly the values (and failure
+    // behavior) of reading with >>, but many times faster.  The stream is
+    // used directly only if the C library would not parse '.' as the
+    // decimal point, since StorageNumberReader relies on strtod().
+    bool hasTime = (indexTime != -1 || indexRange != -1); //MM edit
+    if(*localeconv()->decimal_point=='.' &&
+       std::use_facet<std::numpunct<char> >(fp->getloc()).decimal_point()=='.') {
+        std::string buffer;
+        std::streamoff size = 0;
+        std::streampos start = fp->tellg();
+        if(start!=std::streampos(-1)) {
+            fp->seekg(0,ios::end);
+            size = fp->tellg() - start;
+            fp->seekg(start);
         }
-        delete[] y;
-        // CLOSE FILE
-        delete fp;
-    }else{  //MM the modifications below are to make the Storage class
-            //well behaved when it is given data that does not contain a 
-            //time or a range column
-        int ny = nc;
-        double time;
-        double *y = new double[ny];
-        for(int r=0;r<nr;r++) {
-                time=(double)r;
-                for(int i=0;i<ny;i++)
-                    (*fp)>>y[i];
-                append(time,ny,y);
+        if(size>0) {
+            buffer.resize((size_t)size);
+            fp->read(&buffer[0],size);
+            buffer.resize((size_t)fp->gcount());
         }
-        delete[] y;
-        // CLOSE FILE
-        delete fp;
+        StorageNumberReader in(buffer.data(),buffer.data()+buffer.size());
+        readRows(in,*this,nr,nc,hasTime);
+    } else {
+        readRows(*fp,*this,nr,nc,hasTime);
     }
+    // CLOSE FILE
+    delete fp;
+
     // If what we read was really a sIMM motion file, adjust the data 
     // to account for different assumptions between SIMM.mot OpenSim.sto
 
@@ -280,6 +399,7 @@ Storage(const Storage &aStorage,int aStateIndex,int aN,
         for(int i=0;i<aN && aStateIndex+1+i<originalNumCol;i++) 
             _columnLabels.append(aStorage.getColumnLabels()[aStateIndex+1+i]);
     }
+    indexColumnLabels();
 }
 
 
@@ -312,7 +432,6 @@ setNull()
     _writeSIMMHeader = false;
     setHeaderToken(DEFAULT_HEADER_TOKEN);
     _stepInterval = 1;
-    _lastI = 0;
     _fp = 0;
     _inDegrees = false;
 }
@@ -428,7 +547,7 @@ getHeaderToken() const
 const int Storage::
 getStateIndex(const std::string &aColumnName, int startIndex) const
 {
-    int thisColumnIndex = _columnLabels.findIndex(aColumnName);
+    int thisColumnIndex = findColumnLabel(aColumnName);
     if (thisColumnIndex >= 0)
         // subtract 1 because time is included in the labels but not 
         // in the "state vector"
@@ -440,7 +559,7 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
     std::string::size_type back = aColumnName.rfind("/");
     std::string prefix = aColumnName.substr(0, back);
     std::string shortName = aColumnName.substr(back + 1, aColumnName.length() - back);
-    thisColumnIndex = _columnLabels.findIndex(shortName);
+    thisColumnIndex = findColumnLabel(shortName);
 
     // additional checking for old coordinate state names that have been renamed
     // <coord_name>/value and <coord_name>/speed
@@ -449,13 +568,13 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
             // old formats did not have "/value" so remove it if here
             back = prefix.rfind("/");
             shortName = prefix.substr(back + 1, prefix.length());
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
         else if (shortName == "speed"){
             // replace "/speed" (the latest labeling for speeds) with "_u"
             back = prefix.rfind("/");
             shortName = prefix.substr(back + 1, prefix.length() - back) + "_u";
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
         else if (back < aColumnName.length()) {
             // try replacing the '/' with '.' in the last connection
@@ -463,13 +582,64 @@ getStateIndex(const std::string &aColumnName, int startIndex) const
             shortName.replace(back, 1, ".");
             back = shortName.rfind("/");
             shortName = shortName.substr(back + 1, shortName.length() - back);
-            thisColumnIndex = _columnLabels.findIndex(shortName);
+            thisColumnIndex = findColumnLabel(shortName);
         }
     }
     // subtract 1 because time is included in the labels but not 
     // in the "state vector"
     return thisColumnIndex-1;
 }
+//_____________________________________________________________________________
+/**
+ * Get the state indices corresponding to a list of column names, resolving
+ * each name as getStateIndex() does.
+ *
+ * @param aColumnNames Names of the columns.
+ * @param rStateIndices State index of each column, or -1 if it was not
+ * found.
+ * @return Number of columns found.
+ */
+int Storage::
+getStateIndices(const Array<std::string> &aColumnNames,Array<int> &rStateIndices) const
+{
+    int n = aColumnNames.getSize();
+    rStateIndices.setSize(n);
+    int nFound = 0;
+    for(int i=0;i<n;i++) {
+        // getStateIndex() returns -2 for a column that is not found.
+        int index = getStateIndex(aColumnNames[i]);
+        rStateIndices[i] = (index<0) ? -1 : index;
+        if(index>=0) nFound++;
+    }
+    return(nFound);
+}
+//_____________________________________________________________________________
+/**
+ * Get the index in the column labels of the first column with a given
+ * label, or -1 if there is none.  This is equivalent to
+ * getColumnLabels().findIndex(aLabel), but takes constant time.
+ */
+int Storage::
+findColumnLabel(const std::string &aLabel) const
+{
+    std::unordered_map<std::string,int>::const_iterator iter =
+        _columnLabelIndices.find(aLabel);
+    return((iter==_columnLabelIndices.end()) ? -1 : iter->second);
+}
+//_____________________________________________________________________________
+/**
+ * Rebuild the index of the column labels used by findColumnLabel().  This
+ * must be called whenever _columnLabels is changed.
+ */
+void Storage::
+indexColumnLabels()
+{
+    _columnLabelIndices.clear();
+    _columnLabelIndices.reserve(_columnLabels.getSize());
+    // Keep the first of any duplicate labels, as Array::findIndex() does.
+    for(int i=0;i<_columnLabels.getSize();i++)
+        _columnLabelIndices.insert(std::make_pair(_columnLabels[i],i));
+}
 
 
 //_____________________________________________________________________________
@@ -494,6 +664,7 @@ void Storage::
 parseColumnLabels(const char *aLabels)
 {
     _columnLabels.setSize(0);
+    _columnLabelIndices.clear();
 
     // HANDLE NULL POINTER
     if(aLabels==NULL) return;
@@ -524,6 +695,7 @@ parseColumnLabels(const char *aLabels)
     }
 
     delete[] labelsCopy;
+    indexColumnLabels();
 }
 
 //_____________________________________________________________________________
@@ -534,6 +706,7 @@ void Storage::
 setColumnLabels(const Array<std::string> &aColumnLabels)
 {
     _columnLabels = aColumnLabels;
+    indexColumnLabels();
 }
 
 //_____________________________________________________________________________
@@ -981,9 +1154,18 @@ getData(int aTimeIndex,int aN,SimTK::Vector& v) const
 int Storage::
 getDataAtTime(double aT,int aN,double **rData) const
 {
-
-    // FIND THE CORRECT INTERVAL FOR aT
-    int i = findIndex(_lastI,aT);
+    return interpolateData(findIndex(aT),aT,aN,rData);
+}
+//_____________________________________________________________________________
+/**
+ * Helper function for getDataAtTime.  Linearly interpolate the first aN
+ * states at time aT between the row at index aI, as returned by
+ * findIndex(), and the row that follows it.
+ */
+int Storage::
+interpolateData(int aI,double aT,int aN,double **rData) const
+{
+    int i = aI;
     if((i<0)||(_storage.getSize()<=0)) {
         *rData = NULL;
         return(0);
@@ -1077,6 +1259,27 @@ getDataAtTime(double aT,int aN,SimTK::Vector& v) const
     return r;
 }
 //_____________________________________________________________________________
+/**
+ * Get the first aN states at a specified time, starting the search for the
+ * bracketing rows at the position held by a caller-owned cursor.  The
+ * cursor is advanced to the row found, so a sequence of calls at increasing
+ * times costs (amortized) constant time per call.
+ *
+ * @param aT Time at which to get the states.
+ * @param aN Number of states to get.
+ * @param rData Array where the returned data will be set.  The
+ * size of rData is assumed to be at least aN.
+ * @param rCursor Cursor from which to start, and in which to record, the
+ * search.
+ * @return Number of states that were set.
+ */
+int Storage::
+getDataAtTime(double aT,int aN,Array<double> &rData,TimeCursor& rCursor) const
+{
+    double *data=&rData[0];
+    return interpolateData(findIndex(aT,rCursor),aT,aN,&data);
+}
+//_____________________________________________________________________________
 /**
  * Get the data corresponding to a specified state.  This call is equivalent
  * to getting a column of data from the storage file.
@@ -1132,6 +1335,78 @@ getDataColumn(int aStateIndex,Array<double> &rData) const
     return(nData);
 }
 
+//_____________________________________________________________________________
+/**
+ * Copy a block of adjacent columns into a matrix.  This is equivalent to
+ * calling getDataColumn() for each of the columns, but the rows are visited
+ * only once.  The storage itself keeps its rows; rData is a copy.
+ *
+ * Only columns that are present in every stored state vector are copied.
+ *
+ * @param aStateIndex Index of the state (column) at which to start.
+ * @param aN Number of states (columns) to get.
+ * @param rData Matrix that is resized to getSize() x (number of columns
+ * gotten) and filled with the data.
+ * @return Number of columns gotten.
+ * @throws Exception if aStateIndex or aN is negative, or aStateIndex is
+ * past the columns present in every state vector.
+ */
+int Storage::
+getDataColumns(int aStateIndex,int aN,SimTK::Matrix &rData) const
+{
+    int nr = _storage.getSize();
+    if(aStateIndex<0 || aN<0)
+        throw Exception("Storage.getDataColumns: ERR- negative column index or count.",
+            __FILE__,__LINE__);
+    int nc = getSmallestNumberOfStates() - aStateIndex;
+    if(nr>0 && nc<0)
+        throw Exception("Storage.getDataColumns: ERR- columns out of range.",
+            __FILE__,__LINE__);
+    if(nr<=0 || nc<=0 || aN==0) {
+        rData.resize(nr,0);
+        return(0);
+    }
+    if(aN<nc) nc = aN;
+
+    // ASSIGNMENT
+    rData.resize(nr,nc);
+    for(int i=0;i<nr;i++) {
+        const double *y = _storage[i].getData().get() + aStateIndex;
+        for(int j=0;j<nc;j++) rData(i,j) = y[j];
+    }
+
+    return(nc);
+}
+//_____________________________________________________________________________
+/**
+ * Copy a matrix into a block of adjacent columns, the inverse of
+ * getDataColumns().
+ *
+ * @param aStateIndex Index of the state (column) at which to start.
+ * @param aData Matrix with getSize() rows.  Column j of aData is copied to
+ * state aStateIndex+j.
+ * @throws Exception if aData does not have getSize() rows, or the columns
+ * are not all present in every state vector.
+ */
+void Storage::
+setDataColumns(int aStateIndex,const SimTK::Matrix &aData)
+{
+    int nr = _storage.getSize();
+    if(nr!=aData.nrow())
+        throw Exception("Storage.setDataColumns: ERR- sizes don't match.",
+            __FILE__,__LINE__);
+    int nc = aData.ncol();
+    if(aStateIndex<0 || aStateIndex+nc>getSmallestNumberOfStates())
+        throw Exception("Storage.setDataColumns: ERR- columns out of range.",
+            __FILE__,__LINE__);
+
+    // ASSIGNMENT
+    for(int i=0;i<nr;i++) {
+        double *y = _storage[i].getData().get() + aStateIndex;
+        for(int j=0;j<nc;j++) y[j] = aData(i,j);
+    }
+}
+
 /**
  * Get the data column starting at aTime. Return it in rData
  * rData is preallocated by the caller.
@@ -2300,19 +2575,18 @@ smoothSpline(int aOrder,double aCutoffFrequency)
 
     // LOOP OVER COLUMNS
     double *times=NULL;
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    SimTK::Matrix signals;
+    int nc = getDataColumns(0,getSmallestNumberOfStates(),signals);
+    SimTK::Matrix filt(size,nc);
     getTimeColumn(times,0);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
+        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,
+            &signals(0,i),&filt(0,i));
     }
+    setDataColumns(0,filt);
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 
@@ -2344,17 +2618,13 @@ lowpassIIR(double aCutoffFrequency)
     }
 
     // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    SimTK::Matrix signals;
+    int nc = getDataColumns(0,getSmallestNumberOfStates(),signals);
+    SimTK::Matrix filt(size,nc);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,&signals(0,i),&filt(0,i));
     }
-
-    // CLEANUP
-    delete[] signal;
+    setDataColumns(0,filt);
 }
 
 
@@ -2386,17 +2656,13 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
     }
 
     // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
+    SimTK::Matrix signals;
+    int nc = getDataColumns(0,getSmallestNumberOfStates(),signals);
+    SimTK::Matrix filt(size,nc);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,&signals(0,i),&filt(0,i));
     }
-
-    // CLEANUP
-    delete[] signal;
+    setDataColumns(0,filt);
 }
 
 
@@ -2409,9 +2675,10 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * or at time aT ( aT <= getTime(index) ).
  *
  * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occured later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * is made for aI: the search gallops forward from aI, so its cost grows
+ * only with the log of the distance between aI and the result.
+ * If aI corresponds to a state which occured later than aT, a search
+ * over all stored states is performed by calling findIndex(aT).
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2422,27 +2689,34 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
+    if(!(_storage[aI].getTime()<=aT)) return(findIndex(aT));
 
-    // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    // GALLOP FORWARD UNTIL aT IS BRACKETED
+    int lo=aI,step=1;
+    int hi=lo+step;
+    while(hi<n && _storage[hi].getTime()<=aT) {
+        lo = hi;
+        step *= 2;
+        hi = lo+step;
     }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    if(hi>=n) {
+        hi = n-1;
+        if(_storage[hi].getTime()<=aT) return(hi);
+    }
+    return(findIndexInRange(lo,hi,aT));
 }
 //_____________________________________________________________________________
 /**
  * Find the index of the storage element that occured immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The first guess is made by interpolating between the first and last
+ * stored times, which is exact for uniformly sampled data; otherwise a
+ * binary search is performed.  No search state is kept in the storage, so
+ * this method may be called from several threads at once.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2451,14 +2725,58 @@ findIndex(int aI,double aT) const
 int Storage::
 findIndex(double aT) const
 {
-    if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    int n = _storage.getSize();
+    if(n<=0) return(-1);
+
+    // OUTSIDE THE STORED TIME RANGE
+    double t0 = _storage[0].getTime();
+    double tN = _storage[n-1].getTime();
+    if(!(aT<tN)) return(n-1);
+    if(aT<t0) return(0);
+
+    // INTERPOLATION GUESS
+    // Here t0 <= aT < tN, so n >= 2 and tN > t0.
+    int i = (int)((aT-t0)/(tN-t0)*(n-1));
+    if(i<0) i=0;
+    if(i>n-2) i=n-2;
+    if(aT<_storage[i].getTime()) return(findIndexInRange(0,i,aT));
+    if(aT<_storage[i+1].getTime()) return(i);
+    return(findIndexInRange(i+1,n-1,aT));
+}
+//_____________________________________________________________________________
+/**
+ * Find the index of the storage element that occured immediately before
+ * or at time aT by bisection, given indices that bracket aT
+ * ( getTime(aLo) <= aT < getTime(aHi) ).
+ */
+int Storage::
+findIndexInRange(int aLo,int aHi,double aT) const
+{
+    while(aHi-aLo>1) {
+        int mid = aLo + (aHi-aLo)/2;
+        if(aT<_storage[mid].getTime()) aHi = mid;
+        else aLo = mid;
     }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    return(aLo);
+}
+//_____________________________________________________________________________
+/**
+ * Find the index of the storage element that occured immediately before
+ * or at time aT, starting from and then updating a caller-owned cursor.
+ *
+ * @param aT Time.
+ * @param rCursor Cursor from which to start, and in which to record, the
+ * search.
+ * @return Index preceding or at time aT.  If aT is less than the earliest
+ * time, 0 is returned.
+ * @see TimeCursor
+ */
+int Storage::
+findIndex(double aT,TimeCursor& rCursor) const
+{
+    int i = findIndex(rCursor._index,aT);
+    if(i>=0) rCursor._index = i;
+    return(i);
 }
 //_____________________________________________________________________________
 /** 
@@ -2622,6 +2940,51 @@ setOutputFileName(const std::string& aFileName)
     n = writeColumnLabels(_fp);
 }
 //_____________________________________________________________________________
+/**
+ * Write rows to a file as text, formatted as by StateVector::print().
+ *
+ * Large numbers of rows are split into blocks that are formatted
+ * concurrently, each into its own buffer; the buffers are then written in
+ * order, each with a single write.
+ *
+ * @return The number of characters written, or -1 on error.
+ */
+static int printRows(FILE *rFP,const Array<StateVector> &aRows)
+{
+    static const int MIN_ROWS_PER_THREAD = 256;
+    int nr = aRows.getSize();
+    int nThreads = (int)std::thread::hardware_concurrency();
+    if(nThreads>nr/MIN_ROWS_PER_THREAD) nThreads = nr/MIN_ROWS_PER_THREAD;
+    if(nThreads<1) nThreads = 1;
+
+    // FORMAT
+    IO::DoubleFormatter formatter;
+    std::vector<std::string> buffers(nThreads);
+    auto formatBlock = [&](int aBlock) {
+        int first = (int)((long long)nr*aBlock/nThreads);
+        int last = (int)((long long)nr*(aBlock+1)/nThreads);
+        std::string &buffer = buffers[aBlock];
+        for(int i=first;i<last;i++) {
+            const StateVector &vec = aRows[i];
+            formatter.appendRow(buffer,vec.getTime(),vec.getSize(),
+                vec.getData().get());
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int b=1;b<nThreads;b++) threads.push_back(std::thread(formatBlock,b));
+    formatBlock(0);
+    for(size_t t=0;t<threads.size();t++) threads[t].join();
+
+    // WRITE
+    size_t nTotal = 0;
+    for(int b=0;b<nThreads;b++) {
+        const std::string &buffer = buffers[b];
+        if(fwrite(buffer.c_str(),1,buffer.size(),rFP)!=buffer.size()) return(-1);
+        nTotal += buffer.size();
+    }
+    return((int)nTotal);
+}
+//_____________________________________________________________________________
 /**
  * Print the contents of this storage instance to a file.
  *
@@ -2632,6 +2995,10 @@ setOutputFileName(const std::string& aFileName)
  * The total number of characters written is returned.  If an error occured,
  * a negative number is returned.
  *
+ * A binary file (see isBinaryFileName()) can only be written, so any mode
+ * other than "w" throws an exception, and it has no SIMM header, so
+ * aComment is not written to it.
+ *
  * @param aFileName Name of file to which to save.
  * @param aMode Writing mode: "w" means write and "a" means append.  The 
  * default is "w".
@@ -2641,6 +3008,8 @@ setOutputFileName(const std::string& aFileName)
 bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
+    if(isBinaryFileName(aFileName)) return(printBinary(aFileName,-1,aMode)>0);
+
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
     if(fp==NULL) return(false);
@@ -2684,14 +3053,13 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 //std::cout << aFileName << endl;
 
     // VECTORS
-    for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(false);
-        }
-        nTotal += n;        
+    n = printRows(fp,_storage);
+    if(n<0) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        fclose(fp);
+        return(false);
     }
+    nTotal += n;
 
     // CLOSE
     fclose(fp);
@@ -2710,7 +3078,9 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
  * The argument aDT specifies the time spacing.
  *
  * The total number of characters written is returned.  If an error occured,
- * a negative number is returned.
+ * a negative number is returned.  For a binary file (see isBinaryFileName()),
+ * the number of bytes written is returned, and any mode other than "w"
+ * throws an exception.
  */
 int Storage::
 print(const string &aFileName,double aDT,const string &aMode) const
@@ -2718,6 +3088,8 @@ print(const string &aFileName,double aDT,const string &aMode) const
     // CHECK FOR VALID DT
     if(aDT<=0) return(0);
 
+    if(isBinaryFileName(aFileName)) return(printBinary(aFileName,aDT,aMode));
+
     if (_fp!= NULL) fclose(_fp);
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
@@ -2765,28 +3137,27 @@ print(const string &aFileName,double aDT,const string &aMode) const
         return(n);
     }
 
-    // LOOP THROUGH THE DATA
+    // INTERPOLATE THE STATES
     int i,ny=0;
     double t,*y=NULL;
+    Array<StateVector> rows(StateVector(),0,nr>0 ? nr : 1);
     StateVector vec;
+    TimeCursor cursor;
     for(t=ti,i=0;i<nr;i++,t=ti+aDT*(double)i) {
-
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
+        ny = interpolateData(findIndex(t,cursor),t,ny,&y);
         vec.setStates(t,ny,y);
-
-        // PRINT
-        n = vec.print(fp);
-        if(n<0) {
-            cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-            return(n);
-        }
-        nTotal += n;        
+        rows.append(vec);
     }
+    if(y!=NULL) { delete[] y;  y=NULL; }
 
-    // CLEANUP
+    // PRINT
+    n = printRows(fp,rows);
     fclose(fp);
-    if(y!=NULL) { delete[] y;  y=NULL; }
+    if(n<0) {
+        cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+        return(n);
+    }
+    nTotal += n;
 
     return(nTotal);
 }
@@ -2802,6 +3173,196 @@ printResult(const Storage *aStorage,const std::string &aName,
     else aStorage->print(name,aDT);
 }
 
+//_____________________________________________________________________________
+/**
+ * Whether a file name selects the binary file format, that is, whether it
+ * ends in BINARY_FILE_EXTENSION (in any case).
+ */
+bool Storage::
+isBinaryFileName(const std::string &aFileName)
+{
+    const std::string ext(BINARY_FILE_EXTENSION);
+    return IO::Lowercase(IO::GetSuffix(aFileName,(int)ext.size()))==ext;
+}
+
+//_____________________________________________________________________________
+/**
+ * Helper functions for reading and writing strings in binary files.
+ */
+static void writeBinaryString(FILE *rFP,const std::string &aString)
+{
+    int n = (int)aString.size();
+    fwrite(&n,sizeof(int),1,rFP);
+    if(n>0) fwrite(aString.c_str(),1,n,rFP);
+}
+static bool readBinaryString(FILE *aFP,std::string &rString)
+{
+    int n=0;
+    if(fread(&n,sizeof(int),1,aFP)!=1 || n<0) return(false);
+    rString.resize(n);
+    return(n==0 || fread(&rString[0],1,n,aFP)==(size_t)n);
+}
+
+//_____________________________________________________________________________
+/**
+ * Print the contents of this storage instance to a file in the binary
+ * format (see the class description).  Only the states present in every
+ * state vector are written.
+ *
+ * @param aFileName Name of file to which to save.
+ * @param aDT Time interval between rows (linear interpolation is used).  If
+ * not positive, all stored rows are written without interpolation.
+ * @param aMode Writing mode.  The number of rows is part of the header, so
+ * a binary file cannot be appended to; only "w" is accepted.
+ * @return The number of bytes written, or -1 on error.
+ * @throws Exception if aMode is not "w".
+ */
+int Storage::
+printBinary(const string &aFileName,double aDT,const string &aMode) const
+{
+    if(aMode!="w") {
+        string msg = "Storage.printBinary: binary file "+aFileName+
+            " can only be written (mode \"w\"), not with mode \""+aMode+"\".";
+        throw Exception(msg,__FILE__,__LINE__);
+    }
+
+    // OPEN THE FILE
+    FILE *fp = IO::OpenFile(aFileName,"wb");
+    if(fp==NULL) return(-1);
+
+    // HOW MANY ROWS?
+    int ny = getSmallestNumberOfStates();
+    int nc = ny+1;
+    double ti = getFirstTime();
+    int nr = _storage.getSize();
+    if(aDT>0 && nr>0) nr = IO::ComputeNumberOfSteps(ti,getLastTime(),aDT);
+
+    // WRITE THE HEADER
+    writeBinaryHeader(fp,nr,nc);
+
+    // WRITE THE ROWS
+    Array<double> row(0.0,nc);
+    double *y = &row[1];
+    for(int i=0;i<nr;i++) {
+        if(aDT<=0) {
+            const StateVector &vec = _storage[i];
+            row[0] = vec.getTime();
+            const Array<double> &data = vec.getData();
+            for(int j=0;j<ny;j++) y[j] = data[j];
+        } else {
+            row[0] = ti+aDT*(double)i;
+            getDataAtTime(row[0],ny,&y);
+        }
+        if(fwrite(row.get(),sizeof(double),nc,fp)!=(size_t)nc) {
+            cout << "Storage.printBinary: error printing to " << aFileName << endl;
+            fclose(fp);
+            return(-1);
+        }
+    }
+
+    // CLOSE
+    long nTotal = ftell(fp);
+    if(fclose(fp)!=0 || nTotal<0) return(-1);
+    return((int)nTotal);
+}
+//_____________________________________________________________________________
+/**
+ * Write the header of a binary file (see the class description).
+ *
+ * @param rFP File pointer.
+ * @param aNR Number of rows.
+ * @param aNC Number of columns, including time.
+ * @param rNRPosition If not NULL, set to the position of the number of rows
+ * in the file so that it can be rewritten once the file is complete.
+ */
+int Storage::
+writeBinaryHeader(FILE *rFP,int aNR,int aNC,fpos_t *rNRPosition) const
+{
+    if(rFP==NULL) return(-1);
+
+    int header[] = { 1, BINARY_FILE_VERSION };
+    fwrite(BINARY_FILE_MAGIC,1,sizeof(BINARY_FILE_MAGIC),rFP);
+    fwrite(header,sizeof(int),2,rFP);
+    if(rNRPosition!=NULL) fgetpos(rFP,rNRPosition);
+    int attributes[] = { aNR, aNC, (_inDegrees?1:0) };
+    fwrite(attributes,sizeof(int),3,rFP);
+    writeBinaryString(rFP,getName());
+    writeBinaryString(rFP,getDescription());
+    int nLabels = _columnLabels.getSize();
+    fwrite(&nLabels,sizeof(int),1,rFP);
+    for(int i=0;i<nLabels;i++) writeBinaryString(rFP,_columnLabels[i]);
+
+    return(0);
+}
+//_____________________________________________________________________________
+/**
+ * Read the contents of this storage instance from a file in the binary
+ * format (see the class description).
+ *
+ * @param aFileName Name of the file.
+ * @param readHeadersOnly Whether to stop after reading the name,
+ * description and column labels.
+ */
+void Storage::
+readBinary(const string &aFileName,bool readHeadersOnly)
+{
+    FILE *fp = IO::OpenFile(aFileName,"rb");
+    if(fp==NULL) throw Exception("Storage: ERROR- failed to open file " + aFileName, __FILE__,__LINE__);
+
+    // HEADER
+    char magic[sizeof(BINARY_FILE_MAGIC)];
+    int header[5];
+    std::string name,description;
+    int nLabels=0;
+    bool ok = fread(magic,1,sizeof(magic),fp)==sizeof(magic) &&
+              memcmp(magic,BINARY_FILE_MAGIC,sizeof(magic))==0 &&
+              fread(header,sizeof(int),5,fp)==5 &&
+              readBinaryString(fp,name) && readBinaryString(fp,description) &&
+              fread(&nLabels,sizeof(int),1,fp)==1;
+    if(ok && header[0]!=1) {
+        fclose(fp);
+        throw Exception("Storage: ERROR- file " + aFileName +
+            " was written on a machine with a different byte order", __FILE__,__LINE__);
+    }
+    ok = ok && header[1]<=BINARY_FILE_VERSION && header[2]>=0 && header[3]>=1;
+    _columnLabels.setSize(0);
+    for(int i=0;ok && i<nLabels;i++) {
+        std::string label;
+        ok = readBinaryString(fp,label);
+        _columnLabels.append(label);
+    }
+    indexColumnLabels();
+    if(!ok) {
+        fclose(fp);
+        throw Exception("Storage: ERROR- failed to parse headers of file " + aFileName, __FILE__,__LINE__);
+    }
+    int nr = header[2], nc = header[3];
+    cout << "Storage: file=" << aFileName << " (nr=" << nr << " nc=" << nc << ")" << endl;
+    setName(name);
+    setDescription(description);
+    _inDegrees = (header[4]!=0);
+    _fileVersion = Storage::LatestVersion;
+
+    // CAPACITY
+    _storage.ensureCapacity(nr);
+    _storage.setCapacityIncrement(-1);
+    if(readHeadersOnly) {
+        fclose(fp);
+        return;
+    }
+
+    // DATA
+    // All rows are read at once; there is nothing to parse.
+    std::vector<double> data((size_t)nr*nc);
+    ok = data.empty() || fread(&data[0],sizeof(double),data.size(),fp)==data.size();
+    fclose(fp);
+    if(!ok) throw Exception("Storage: ERROR- file " + aFileName + " is truncated", __FILE__,__LINE__);
+    for(int r=0;r<nr;r++) {
+        const double *row = &data[(size_t)r*nc];
+        append(row[0],nc-1,row+1);
+    }
+}
+
 //_____________________________________________________________________________
 /**
  * Write the header.
@@ -2822,11 +3383,35 @@ writeHeader(FILE *rFP,double aDT) const
     }
     nc = getSmallestNumberOfStates()+1;
 
+    return(writeHeader(rFP,nr,nc));
+}
+//_____________________________________________________________________________
+/**
+ * Write the header for a given number of rows and columns.
+ *
+ * @param rFP File pointer.
+ * @param aNR Number of rows.
+ * @param aNC Number of columns, including time.
+ * @param rNRPosition If not NULL, set to the position of the number of rows
+ * in the file, which is then padded to a fixed width so that it can be
+ * rewritten once the file is complete.
+ */
+int Storage::
+writeHeader(FILE *rFP,int aNR,int aNC,fpos_t *rNRPosition) const
+{
+    if(rFP==NULL) return(-1);
+
     // ATTRIBUTES
     fprintf(rFP,"%s\n",getName().c_str());
     fprintf(rFP,"version=%d\n",LatestVersion);
-    fprintf(rFP,"nRows=%d\n",nr);
-    fprintf(rFP,"nColumns=%d\n",nc);
+    if(rNRPosition!=NULL) {
+        fprintf(rFP,"nRows=");
+        fgetpos(rFP,rNRPosition);
+        fprintf(rFP,"%-10d\n",aNR);
+    } else {
+        fprintf(rFP,"nRows=%d\n",aNR);
+    }
+    fprintf(rFP,"nColumns=%d\n",aNC);
     fprintf(rFP,"inDegrees=%s\n",(_inDegrees?"yes":"no"));
 
     return(0);
@@ -3140,6 +3725,7 @@ exchangeTimeColumnWith(int aColumnIndex)
     string swap = _columnLabels.get(0);
     _columnLabels.set(aColumnIndex+1, swap);
     _columnLabels.set(0, "time");
+    indexColumnLabels();
 
 }
 //_____________________________________________________________________________
@@ -3179,6 +3765,7 @@ void Storage::postProcessSIMMMotion()
                         StateVector vec = _storage.get(0);
                         vec.getData().append(0.0);
                         _columnLabels.append("time");
+                        indexColumnLabels();
                         exchangeTimeColumnWith(_columnLabels.findIndex("time"));
                     }
                     else
@@ -3187,6 +3774,7 @@ void Storage::postProcessSIMMMotion()
                 else {  // time  column from range, size
                     double timeStep = (end - start)/(_storage.getSize()-1);
                     _columnLabels.append("time");
+                    indexColumnLabels();
                     for(int i=0; i<_storage.getSize(); i++){
                         Array<double>& data=_storage.updElt(i).getData();
                         data.append(i*timeStep);
@@ -3211,8 +3799,8 @@ void Storage::postProcessSIMMMotion()
 double Storage::compareColumn(Storage& aOtherStorage, const std::string& aColumnName, double startTime, double endTime)
 {
     //Subtract one since, the data does not include the time column anymore.
-    int thisColumnIndex=_columnLabels.findIndex(aColumnName)-1;
-    int otherColumnIndex = aOtherStorage._columnLabels.findIndex(aColumnName)-1;
+    int thisColumnIndex=findColumnLabel(aColumnName)-1;
+    int otherColumnIndex = aOtherStorage.findColumnLabel(aColumnName)-1;
 
     double theDiff = SimTK::NaN;
 
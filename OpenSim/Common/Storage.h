@@ -33,6 +33,7 @@
 #include "Units.h"
 #include "SimTKcommon.h"
 #include "StorageInterface.h"
+#include <unordered_map>
 
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
@@ -60,6 +61,24 @@ typedef std::map<std::string, std::string, std::less<std::string> > MapKeysToVal
  * TimeIndex, and a particular state (or column) is indexed by the
  * StateIndex.
  *
+ * A Storage whose file name ends in BINARY_FILE_EXTENSION (".stob") is read
+ * and written in a binary format instead of as text.  The file holds, in
+ * the byte order of the machine that wrote it:
+ *
+ * - the 8 characters "OSIMSTOB";
+ * - the ints 1 (to detect a byte order mismatch), the format version, the
+ *   number of rows, the number of columns (including time), and 1 or 0 for
+ *   whether angles are in degrees;
+ * - the name, the description, the number of column labels, and each
+ *   column label, every string written as an int length followed by its
+ *   characters;
+ * - the rows, each written as its time followed by its states, as doubles.
+ *
+ * The data are read with a single bulk read and need no parsing, so
+ * binary files load and save far faster than .sto/.mot text files.  Since
+ * the number of rows is in the header, a binary file cannot be printed with
+ * the append mode "a", and it has no SIMM header for a print() comment.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -75,6 +94,8 @@ public:
     static const char *DEFAULT_HEADER_TOKEN;
     static const char* DEFAULT_HEADER_SEPARATOR;
     static const int MAX_RESAMPLE_SIZE;
+    /** File name extension that selects the binary file format. */
+    static const char* BINARY_FILE_EXTENSION;
 protected:
     static std::string simmReservedKeys[];
 
@@ -84,11 +105,11 @@ protected:
     std::string _headerToken;
     /** Column labels. */
     Array<std::string> _columnLabels;
+    /** Index of the first column with each label in _columnLabels. */
+    std::unordered_map<std::string,int> _columnLabelIndices;
     /** Step interval at which states in a simulation are stored. See
     store(). */
     int _stepInterval;
-    /** Last index at which a search was started. */
-    mutable int _lastI;
     /** Flag for whether or not to insert a SIMM style header. */
     bool _writeSIMMHeader;
     /** Units in which the data is represented. */
@@ -125,6 +146,24 @@ public:
     Storage& operator=(const Storage &aStorage);
 #endif
 
+#ifndef SWIG
+    /** Position of a sequential time lookup, owned by the caller.  Passing
+    the same cursor to successive findIndex() or getDataAtTime() calls with
+    increasing times makes each lookup (amortized) constant time, and since
+    the Storage itself keeps no search state, several threads may read one
+    Storage concurrently as long as each uses its own cursor. */
+    class TimeCursor {
+    public:
+        TimeCursor() : _index(0) {}
+        /** Index of the row found by the most recent lookup. */
+        int getIndex() const { return _index; }
+        void reset() { _index = 0; }
+    private:
+        friend class Storage;
+        int _index;
+    };
+#endif
+
     const std::string& getName() const { return _name; };
     const std::string& getDescription() const { return _description; };
     void setName(const std::string& aName) { _name = aName; };
@@ -185,8 +224,14 @@ public:
     int getDataAtTime(double aTime,int aN,double *rData) const;
     int getDataAtTime(double aTime,int aN,Array<double> &rData) const;
     int getDataAtTime(double aTime,int aN,SimTK::Vector& v) const;
+#ifndef SWIG
+    int getDataAtTime(double aTime,int aN,Array<double> &rData,
+                      TimeCursor& rCursor) const;
+#endif
     int getDataColumn(int aStateIndex,double *&rData) const;
     int getDataColumn(int aStateIndex,Array<double> &rData) const;
+    int getDataColumns(int aStateIndex,int aN,SimTK::Matrix &rData) const;
+    void setDataColumns(int aStateIndex,const SimTK::Matrix &aData);
     // Set entries in a column of the storage to a fixed value, 
     void setDataColumnToFixedValue(const std::string& columnName, double newValue);
     void setDataColumn(int aStateIndex,const Array<double> &aData);
@@ -219,6 +264,7 @@ public:
     const std::string& getHeaderToken() const;
     // COLUMN LABELS
     const int getStateIndex(const std::string &aColumnName, int startIndex=0) const;
+    int getStateIndices(const Array<std::string> &aColumnNames,Array<int> &rStateIndices) const;
     void setColumnLabels(const Array<std::string> &aColumnLabels);
     const Array<std::string> &getColumnLabels() const;
     //--------------------------------------------------------------------------
@@ -281,6 +327,9 @@ public:
     //--------------------------------------------------------------------------
     virtual int findIndex(double aT) const;
     virtual int findIndex(int aI,double aT) const;
+#ifndef SWIG
+    int findIndex(double aT,TimeCursor& rCursor) const;
+#endif
     void findFrameRange(double aStartTime, double aEndTime, int& oStartFrame, int& oEndFrame) const;
     double resample(double aDT, int aDegree);
     double resampleLinear(double aDT);
@@ -302,14 +351,26 @@ public:
     // convenience function for Analyses and DerivCallbacks
     static void printResult(const Storage *aStorage,const std::string &aName,
         const std::string &aDir,double aDT,const std::string &aExtension);
+    static bool isBinaryFileName(const std::string &aFileName);
     void interpolateAt(const Array<double> &targetTimes);
 private:
+    int printBinary(const std::string &aFileName,double aDT=-1,
+        const std::string &aMode="w") const;
+    void readBinary(const std::string &aFileName,bool readHeadersOnly);
     int writeHeader(FILE *rFP,double aDT=-1) const;
+    int writeHeader(FILE *rFP,int aNR,int aNC,fpos_t *rNRPosition=NULL) const;
+    int writeBinaryHeader(FILE *rFP,int aNR,int aNC,fpos_t *rNRPosition=NULL) const;
     int writeSIMMHeader(FILE *rFP,double aDT=-1, const char*aComment=0) const;
     int writeDescription(FILE *rFP) const;
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    int findIndexInRange(int aLo,int aHi,double aT) const;
+    int findColumnLabel(const std::string &aLabel) const;
+    void indexColumnLabels();
+    int interpolateData(int aI,double aT,int aN,double **rData) const;
+
+    friend class StorageWriter;
 
 //=============================================================================
 };  // END of class Storage
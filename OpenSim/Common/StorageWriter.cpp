@@ -0,0 +1,247 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  StorageWriter.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2012 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StorageWriter.h"
+#include <iostream>
+#include <limits>
+#include "Exception.h"
+#include "IO.h"
+#include "Storage.h"
+
+using namespace OpenSim;
+using namespace std;
+
+//=============================================================================
+// STATICS
+//=============================================================================
+const int StorageWriter::DEFAULT_CHUNK_SIZE = 256;
+const int StorageWriter::DEFAULT_MAX_PENDING_CHUNKS = 4;
+
+//=============================================================================
+// CONSTRUCTOR(S) AND DESTRUCTOR
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Open a file for writing.  Nothing is written until the first row is
+ * appended or the writer is closed.
+ *
+ * @param aFileName Name of the file.
+ * @param aHeader Storage whose name, description, column labels and
+ * inDegrees flag are written to the header.  Its rows are ignored.
+ * @param aChunkSize Number of rows handed to the writing thread at a time.
+ * @param aMaxPendingChunks Maximum number of chunks waiting to be written.
+ */
+StorageWriter::
+StorageWriter(const string &aFileName,const Storage &aHeader,
+    int aChunkSize,int aMaxPendingChunks) :
+    _fileName(aFileName),
+    _header(new Storage(aHeader,false)),
+    _fp(NULL),
+    _binary(Storage::isBinaryFileName(aFileName)),
+    _nc(0),
+    _chunkSize(aChunkSize>0 ? aChunkSize : 1),
+    _maxPendingChunks(aMaxPendingChunks>0 ? aMaxPendingChunks : 1),
+    _nr(0),
+    _failed(false),
+    _done(false)
+{
+    _fp = IO::OpenFile(aFileName,_binary ? "wb" : "w");
+    if(_fp==NULL)
+        throw Exception("StorageWriter: ERROR- could not open file " + aFileName,
+            __FILE__,__LINE__);
+}
+//_____________________________________________________________________________
+/**
+ * Destructor.  The file is closed if it is still open.
+ */
+StorageWriter::~StorageWriter()
+{
+    close();
+}
+
+//=============================================================================
+// WRITING
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Append a row.  The row is written by the background thread once its chunk
+ * is full and a row with a later time has been appended, or by close().
+ * Until then the row can still be replaced.
+ *
+ * @param aT Time stamp of the row.
+ * @param aN Number of states.
+ * @param aY States.
+ */
+void StorageWriter::
+append(double aT,int aN,const double *aY)
+{
+    if(_fp==NULL)
+        throw Exception("StorageWriter.append: ERROR- file " + _fileName +
+            " is closed",__FILE__,__LINE__);
+
+    // FIRST ROW
+    if(_nc==0) {
+        writeHeader(aN+1);
+        _chunk.reserve((size_t)_chunkSize*_nc);
+        _thread = std::thread(&StorageWriter::writeChunks,this);
+    }
+
+    // REPLACE A ROW WITH THE SAME TIME
+    size_t n = _chunk.size();
+    if(n>0 && _chunk[n-_nc]==aT) {
+        _chunk.resize(n-_nc);
+    } else {
+        if(n==(size_t)_chunkSize*_nc) submitChunk();
+        _nr++;
+    }
+
+    // ROW
+    int ny = _nc-1;
+    _chunk.push_back(aT);
+    for(int i=0;i<ny;i++)
+        _chunk.push_back(i<aN ? aY[i] : std::numeric_limits<double>::quiet_NaN());
+}
+//_____________________________________________________________________________
+/**
+ * Write the remaining rows, fill in the number of rows in the header and
+ * close the file.  Calling close() on a closed writer does nothing.
+ *
+ * @return true if the whole file was written successfully.
+ */
+bool StorageWriter::
+close()
+{
+    if(_fp==NULL) return(!_failed);
+
+    // REMAINING ROWS
+    if(_nc==0) {
+        writeHeader(_header->getColumnLabels().getSize()>0 ?
+            _header->getColumnLabels().getSize() : 1);
+    } else {
+        if(!_chunk.empty()) submitChunk();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _chunkAdded.notify_one();
+        _thread.join();
+    }
+
+    // NUMBER OF ROWS
+    if(fsetpos(_fp,&_nrPosition)==0) {
+        if(_binary) {
+            if(fwrite(&_nr,sizeof(int),1,_fp)!=1) _failed = true;
+        } else {
+            if(fprintf(_fp,"%-10d",_nr)<0) _failed = true;
+        }
+    } else {
+        _failed = true;
+    }
+
+    // CLOSE
+    if(fclose(_fp)!=0) _failed = true;
+    _fp = NULL;
+    if(_failed)
+        cout << "StorageWriter.close: error writing to " << _fileName << endl;
+    return(!_failed);
+}
+//_____________________________________________________________________________
+/**
+ * Write the header, leaving room for the number of rows to be filled in by
+ * close().
+ *
+ * @param aNC Number of columns, including time.
+ */
+void StorageWriter::
+writeHeader(int aNC)
+{
+    _nc = aNC;
+    if(_binary) {
+        _header->writeBinaryHeader(_fp,0,_nc,&_nrPosition);
+    } else {
+        _header->writeHeader(_fp,0,_nc,&_nrPosition);
+        _header->writeDescription(_fp);
+        _header->writeColumnLabels(_fp);
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Hand the current chunk to the writing thread, first waiting for room if
+ * the maximum number of chunks are already waiting to be written.
+ */
+void StorageWriter::
+submitChunk()
+{
+    std::vector<double> chunk;
+    chunk.reserve((size_t)_chunkSize*_nc);
+    chunk.swap(_chunk);
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while((int)_pending.size()>=_maxPendingChunks)
+            _chunkWritten.wait(lock);
+        _pending.push_back(std::vector<double>());
+        _pending.back().swap(chunk);
+    }
+    _chunkAdded.notify_one();
+}
+//_____________________________________________________________________________
+/**
+ * Body of the writing thread: write chunks as they arrive until close() is
+ * called and no chunks remain.
+ */
+void StorageWriter::
+writeChunks()
+{
+    std::vector<double> chunk;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(_pending.empty() && !_done)
+                _chunkAdded.wait(lock);
+            if(_pending.empty()) return;
+            chunk.swap(_pending.front());
+            _pending.pop_front();
+        }
+        _chunkWritten.notify_one();
+        // After a failure the remaining chunks are discarded.
+        if(!_failed && !writeChunk(chunk)) _failed = true;
+        chunk.clear();
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Write the rows of a chunk to the file.
+ *
+ * @return true on success.
+ */
+bool StorageWriter::
+writeChunk(const vector<double> &aChunk)
+{
+    if(aChunk.empty()) return(true);
+    if(_binary)
+        return(fwrite(&aChunk[0],sizeof(double),aChunk.size(),_fp)==aChunk.size());
+
+    std::string text;
+    for(size_t r=0;r<aChunk.size();r+=_nc)
+        _formatter.appendRow(text,aChunk[r],_nc-1,aChunk.data()+r+1);
+    return(fwrite(text.c_str(),1,text.size(),_fp)==text.size());
+}
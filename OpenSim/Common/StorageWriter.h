@@ -0,0 +1,151 @@
+#ifndef OPENSIM_STORAGE_WRITER_H_
+#define OPENSIM_STORAGE_WRITER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  StorageWriter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2012 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "IO.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+namespace OpenSim {
+
+class Storage;
+
+//=============================================================================
+//=============================================================================
+/**
+ * A class for writing rows of a Storage file as they are produced, without
+ * keeping them in memory.
+ *
+ * The name, description, column labels and inDegrees flag of the file are
+ * taken from a Storage (usually empty) when the writer is constructed.
+ * Rows passed to append() are collected into chunks of a fixed number of
+ * rows; full chunks are handed to a background thread that formats and
+ * writes them.  At most a fixed number of chunks wait to be written: when
+ * the disk falls behind, append() blocks until a chunk has been written, so
+ * memory use does not grow with the number of rows.  The number of rows in
+ * the header is filled in by close().
+ *
+ * The file is written in the binary format if its name ends in
+ * Storage::BINARY_FILE_EXTENSION, and as text otherwise.  Files written by
+ * this class are read back with the Storage file constructor as usual.
+ *
+ * As with Storage::append(), a row whose time equals the time of the
+ * previous row replaces that row.
+ *
+ * @see Storage
+ */
+class OSIMCOMMON_API StorageWriter
+{
+//=============================================================================
+// DATA
+//=============================================================================
+public:
+    /** Default number of rows per chunk. */
+    static const int DEFAULT_CHUNK_SIZE;
+    /** Default maximum number of chunks waiting to be written. */
+    static const int DEFAULT_MAX_PENDING_CHUNKS;
+private:
+    /** Name of the file. */
+    std::string _fileName;
+    /** Storage holding the name, description and column labels. */
+    std::unique_ptr<Storage> _header;
+    /** File pointer; NULL once closed. */
+    FILE *_fp;
+    /** Whether the file is in the binary format. */
+    bool _binary;
+    /** Number of columns, including time, set by the first row.  Later
+    rows with fewer states are padded with NaN; extra states are dropped. */
+    int _nc;
+    /** Number of rows per chunk. */
+    int _chunkSize;
+    /** Maximum number of chunks waiting to be written. */
+    int _maxPendingChunks;
+    /** Number of rows appended, counting each replaced row once. */
+    int _nr;
+    /** Position of the number of rows in the header. */
+    fpos_t _nrPosition;
+    /** Formatter for the values of text files. */
+    IO::DoubleFormatter _formatter;
+    /** Chunk being filled, as consecutive rows of _nc values. */
+    std::vector<double> _chunk;
+    /** Whether writing to the file failed. */
+    bool _failed;
+    /** Full chunks waiting to be written. */
+    std::deque<std::vector<double> > _pending;
+    /** Whether the writing thread should stop once _pending is empty. */
+    bool _done;
+    std::mutex _mutex;
+    /** Signals that a chunk was added to _pending or that _done was set. */
+    std::condition_variable _chunkAdded;
+    /** Signals that a chunk was removed from _pending. */
+    std::condition_variable _chunkWritten;
+    std::thread _thread;
+
+//=============================================================================
+// METHODS
+//=============================================================================
+public:
+    StorageWriter(const std::string &aFileName,const Storage &aHeader,
+        int aChunkSize=DEFAULT_CHUNK_SIZE,
+        int aMaxPendingChunks=DEFAULT_MAX_PENDING_CHUNKS);
+    virtual ~StorageWriter();
+private:
+    StorageWriter(const StorageWriter&);
+    StorageWriter& operator=(const StorageWriter&);
+
+public:
+    //--------------------------------------------------------------------------
+    // GET
+    //--------------------------------------------------------------------------
+    const std::string& getFileName() const { return _fileName; }
+    int getNumColumns() const { return _nc; }
+    int getSize() const { return _nr; }
+    bool isOpen() const { return _fp!=NULL; }
+
+    //--------------------------------------------------------------------------
+    // WRITING
+    //--------------------------------------------------------------------------
+    void append(double aT,int aN,const double *aY);
+    bool close();
+
+private:
+    void writeHeader(int aNC);
+    void submitChunk();
+    void writeChunks();
+    bool writeChunk(const std::vector<double> &aChunk);
+
+//=============================================================================
+};  // END of class StorageWriter
+
+}; //namespace
+//=============================================================================
+//=============================================================================
+
+#endif // OPENSIM_STORAGE_WRITER_H_
@@ -577,6 +577,17 @@ int main() {
         bar.setStateVariableValue(s, "fiberLength", 1.5);
         bar.setStateVariableValue(s, "activation", 0);
 
+        // Index-based access must agree with access by name.
+        int fiberLengthIndex = bar.getStateVariableIndex("fiberLength");
+        ASSERT(fiberLengthIndex >= 0);
+        ASSERT(bar.getStateVariableIndex("notAStateVariable") == -1);
+        ASSERT_EQUAL(1.5, bar.getStateVariableValue(s, fiberLengthIndex), 1e-10);
+        bar.setStateVariableValue(s, fiberLengthIndex, 2.0);
+        ASSERT_EQUAL(2.0, bar.getStateVariableValue(s, "fiberLength"), 1e-10);
+        ASSERT_EQUAL(2.0,
+            bar.getStateVariableValues(s)[fiberLengthIndex], 1e-10);
+        bar.setStateVariableValue(s, fiberLengthIndex, 1.5);
+
         int nu3 = system3.getMatterSubsystem().getNumMobilities();
 
         // realize simbody system to velocity stage
@@ -21,6 +21,8 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Constant.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -38,6 +40,31 @@ int main() {
         for (int i = 0; i < 10*(size-1); ++i) {
             ASSERT_EQUAL(sin(0.01*i), spline.calcValue(SimTK::Vector(1, 0.01*i)), 1e-4, __FILE__, __LINE__);
         }
+
+        // Evaluating a whole set, sharing the knot interval between splines,
+        // must agree with evaluating each function on its own.
+        GCVSplineSet set;
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < size; ++i)
+                y[i] = sin((j+1)*x[i]) + j;
+            set.adoptAndAppend(new GCVSpline(2*j+1, size, x, y));
+        }
+        set.adoptAndAppend(new Constant(2.0));
+        Array<double> values, firstDerivatives, secondDerivatives, single;
+        for (int i = 0; i < 10*(size-1); i += 7) {
+            double t = 0.01*i;
+            set.evaluate(values, firstDerivatives, secondDerivatives, t);
+            for (int order = 0; order <= 2; ++order) {
+                set.evaluate(single, order, t);
+                const Array<double>& batch = order == 0 ? values :
+                    (order == 1 ? firstDerivatives : secondDerivatives);
+                for (int j = 0; j < set.getSize(); ++j) {
+                    double expected = set.FunctionSet::evaluate(j, order, t);
+                    ASSERT_EQUAL(expected, single[j], 1e-9, __FILE__, __LINE__);
+                    ASSERT_EQUAL(expected, batch[j], 1e-9, __FILE__, __LINE__);
+                }
+            }
+        }
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -229,6 +229,35 @@ int main()
         ASSERT(loc == 1);
         int notFound = objWithListProp.getProperty_list_SerializableObject().findIndexForName("Third");
         ASSERT(notFound == -1);
+
+        // Name lookup in a Set large enough to be indexed must follow
+        // appends, removals and renames, and find the first of duplicates.
+        ObjSet namedSet;
+        for (int i = 0; i < 20; ++i) {
+            SerializableObject* obj = new SerializableObject();
+            obj->setName("obj" + std::to_string(i % 10 == 9 ? 3 : i));
+            namedSet.adoptAndAppend(obj);
+        }
+        ASSERT(namedSet.getIndex("obj3") == 3);
+        ASSERT(namedSet.getIndex("obj3", 4) == 9);
+        ASSERT(namedSet.getIndex("obj12") == 12);
+        ASSERT(!namedSet.contains("obj9"));
+        namedSet.get(12).setName("obj9");
+        ASSERT(namedSet.getIndex("obj9") == 12);
+        ASSERT(!namedSet.contains("obj12"));
+        namedSet.remove(0);
+        ASSERT(namedSet.getIndex("obj9") == 11);
+        ASSERT(&namedSet.get("obj3") == &namedSet.get(2));
+
+        // A copy indexes its own objects; renames in one set are not seen
+        // by the other.
+        ObjSet copiedSet(namedSet);
+        ASSERT(copiedSet.getIndex("obj9") == 11);
+        copiedSet.get(11).setName("copied9");
+        ASSERT(copiedSet.getIndex("copied9") == 11);
+        ASSERT(!copiedSet.contains("obj9"));
+        ASSERT(namedSet.getIndex("obj9") == 11);
+        ASSERT(!namedSet.contains("copied9"));
     }
     catch(const std::exception& e) {
         cerr << "EXCEPTION: " << e.what() << endl;
@@ -1131,6 +1131,41 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/*
+ 5. A tabulated copy of the curve must agree with the exact curve, within the
+    error it reports, across the curve domain and its linear extrapolation.
+*/
+void testMuscleCurveTable(SmoothSegmentedFunction mcf, double tol)
+{
+    cout << "   TEST: Tabulated Evaluation " << endl;
+    SmoothSegmentedFunction table(mcf);
+    SimTK_TEST(!table.isTabulated());
+    table.buildTable(tol);
+    SimTK_TEST(table.isTabulated());
+
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double width = domain(1)-domain(0);
+    int n = 1000;
+    for(int i=0; i<=n; i++){
+        double x = domain(0) - 0.1*width + 1.2*width*i/n;
+        for(int order=0; order<=2; order++){
+            double bound = max(2*table.getTableError(order), 10*tol);
+            SimTK_TEST_EQ_TOL(table.calcDerivative(x,order), 
+                              mcf.calcDerivative(x,order), bound);
+        }
+    }
+    SimTK_TEST(table.getTableError(0) <= tol);
+    printf("   passed: table errors %e, %e and %e\n",
+        table.getTableError(0), table.getTableError(1), 
+        table.getTableError(2));
+
+    table.clearTable();
+    SimTK_TEST(!table.isTabulated());
+    SimTK_TEST(table.calcValue(domain(0)+0.3*width) 
+                == mcf.calcValue(domain(0)+0.3*width));
+    cout << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1213,6 +1248,9 @@ int main(int argc, char* argv[])
         //4. Test for montonicity where appropriate
             testMonotonicity(tendonCurveSample);
 
+        //5. Test the tabulated evaluation
+            testMuscleCurveTable(tendonCurve, 1e-9);
+
         //5. Testing Exceptions
             cout << endl;
             cout << "   Exception Testing" << endl;
@@ -1787,6 +1825,9 @@ int main(int argc, char* argv[])
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberfalCurve,fiberfalCurveSample);
 
+        //4. Test the tabulated evaluation across several Bezier sections
+            testMuscleCurveTable(fiberfalCurve, 1e-9);
+
             //fiberfalCurve.MuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
        
         //4. Exception Testing
@@ -22,6 +22,8 @@
 
 #include <fstream>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/StorageWriter.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -64,6 +66,26 @@ int main() {
     
         ASSERT(st->getStateIndex("v2")==1);
 
+        // Test bulk column copies
+        SimTK::Matrix block;
+        ASSERT(st->getDataColumns(0, 5, block)==2);
+        ASSERT(block.nrow()==2 && block.ncol()==2);
+        ASSERT(block(0,0)==10.0 && block(1,0)==20.0);
+        ASSERT(block(0,1)==20.0 && block(1,1)==40.0);
+        ASSERT(st->getDataColumns(1, 1, block)==1);
+        ASSERT(block(1,0)==40.0);
+        block *= 2.0;
+        st->setDataColumns(1, block);
+        ASSERT(st->getStateVector(1)->getData()[1]==80.0);
+        block /= 2.0;
+        st->setDataColumns(1, block);
+        ASSERT_THROW(OpenSim::Exception, st->getDataColumns(3, 1, block));
+        ASSERT_THROW(OpenSim::Exception, st->getDataColumns(-1, 1, block));
+        ASSERT_THROW(OpenSim::Exception,
+            st->setDataColumns(1, SimTK::Matrix(3, 1, 0.0)));
+        ASSERT_THROW(OpenSim::Exception,
+            st->setDataColumns(1, SimTK::Matrix(2, 2, 0.0)));
+
         Storage st2("testDiff.sto");
         // Test Comparison
         double diff = st->compareColumn(st2, stdLabels[1], 0.);
@@ -72,6 +94,111 @@ int main() {
         ASSERT(fabs(diff) < 1E-7);
 
         delete st;
+
+        // Test that the binary format round-trips exactly
+        Storage stb("test.sto");
+        stb.setDescription("binary round-trip");
+        stb.getStateVector(0)->getData()[0] = 1.0/3.0;
+        ASSERT(stb.print("test.stob"));
+        Storage stb2("test.stob");
+        ASSERT(stb2.getSize()==stb.getSize());
+        ASSERT(stb2.getName()==stb.getName());
+        ASSERT(stb2.getDescription()=="binary round-trip");
+        ASSERT(stb2.getColumnLabels().getSize()==3);
+        for(i=0; i<3; i++)
+            ASSERT(stb2.getColumnLabels()[i]==stdLabels[i]);
+        for(i=0; i<stb.getSize(); i++){
+            ASSERT(stb2.getStateVector(i)->getTime()==stb.getStateVector(i)->getTime());
+            for(int j=0; j<2; j++)
+                ASSERT(stb2.getStateVector(i)->getData()[j]==stb.getStateVector(i)->getData()[j]);
+        }
+        // Binary files cannot be appended to, and report the bytes written
+        ASSERT_THROW(OpenSim::Exception, stb.print("test.stob","a"));
+        ASSERT(stb.print("test.stob",0.01)>0);
+
+        // Test that streamed files read back like printed ones
+        string streamNames[] = {"testStream.sto", "testStream.stob"};
+        for(int k=0; k<2; k++) {
+            StorageWriter writer(streamNames[k], stb, 3, 1);
+            for(i=0; i<10; i++) {
+                double y[] = {0.5*i, -2.0*i};
+                writer.append(0.1*i, 2, y);
+                if(i==4) writer.append(0.1*i, 2, y);
+                // The last row of a full chunk can still be replaced.
+                if(i==2) {
+                    double z[] = {7.0, 8.0};
+                    writer.append(0.1*i, 2, z);
+                }
+            }
+            ASSERT(writer.getSize()==10);
+            ASSERT(writer.close());
+            Storage streamed(streamNames[k]);
+            ASSERT(streamed.getSize()==10);
+            ASSERT(streamed.getColumnLabels().getSize()==3);
+            ASSERT(streamed.getColumnLabels()[2]==stdLabels[2]);
+            ASSERT(streamed.getStateVector(9)->getData()[0]==4.5);
+            ASSERT(streamed.getStateVector(9)->getData()[1]==-18.0);
+            ASSERT(streamed.getStateVector(2)->getData()[0]==7.0);
+            ASSERT(streamed.getStateVector(3)->getData()[0]==1.5);
+        }
+
+        // Test label lookup, including the labels of earlier versions
+        Storage stl;
+        string oldLabels[] = {"time", "knee", "knee_u", "bushing.fx", "knee"};
+        Array<string> labels;
+        labels.append(5, oldLabels);
+        stl.setColumnLabels(labels);
+        Array<string> newNames;
+        newNames.append("knee");
+        newNames.append("/jointset/knee_r/knee/value");
+        newNames.append("/jointset/knee_r/knee/speed");
+        newNames.append("/forceset/bushing/fx");
+        newNames.append("ankle");
+        Array<int> indices;
+        ASSERT(stl.getStateIndices(newNames, indices)==4);
+        ASSERT(indices[0]==0 && indices[1]==0 && indices[2]==1);
+        ASSERT(indices[3]==2 && indices[4]==-1);
+
+        // Test that fast formatting matches fprintf
+        double formatValues[] = {0.0, -0.0, 0.5, -2.5e-9, 1.000000005,
+            0.123456785, -123456.7890123, 1e20, -3e-300,
+            SimTK::NaN, SimTK::Infinity};
+        for(int k=0; k<2; k++) {
+            IO::SetScientific(k==1);
+            IO::DoubleFormatter formatter;
+            for(i=0; i<11; i++) {
+                string formatted;
+                formatter.append(formatted, formatValues[i]);
+                char expected[IO_STRLEN];
+                sprintf(expected, IO::GetDoubleOutputFormat(), formatValues[i]);
+                ASSERT(formatted==expected);
+            }
+        }
+        IO::SetScientific(false);
+
+        // Test time lookup on non-uniformly sampled data with a repeated time
+        Storage st3;
+        double times[] = {0.0, 0.1, 0.15, 0.15, 0.4, 1.0, 1.1};
+        int nTimes = 7;
+        for(i=0; i<nTimes; i++)
+            st3.append(times[i], 1, &times[i], false);
+        ASSERT(st3.findIndex(-1.0)==0);
+        ASSERT(st3.findIndex(0.0)==0);
+        ASSERT(st3.findIndex(0.12)==1);
+        ASSERT(st3.findIndex(0.15)==3);
+        ASSERT(st3.findIndex(0.9)==4);
+        ASSERT(st3.findIndex(1.1)==6);
+        ASSERT(st3.findIndex(5.0)==6);
+        ASSERT(st3.findIndex(2, 0.05)==0);
+        ASSERT(st3.findIndex(1, 1.05)==5);
+        Storage::TimeCursor cursor;
+        Array<double> value(0.0, 1);
+        for(i=0; i<=110; i++) {
+            double t = 0.01*i;
+            ASSERT(st3.findIndex(t, cursor)==st3.findIndex(t));
+            st3.getDataAtTime(t, 1, value, cursor);
+            ASSERT(fabs(value[0]-t) < 1E-12);
+        }
     }
     catch (const Exception& e) {
         e.print(cerr);
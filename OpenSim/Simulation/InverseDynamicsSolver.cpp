@@ -24,6 +24,10 @@
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace SimTK;
@@ -36,7 +40,8 @@ namespace OpenSim {
  *
  * @param model to assemble
  */
-InverseDynamicsSolver::InverseDynamicsSolver(const Model &model) : Solver(model)
+InverseDynamicsSolver::InverseDynamicsSolver(const Model &model) : Solver(model),
+    _numThreads(1)
 {
     setAuthors("Ajay Seth");
 }
@@ -134,11 +139,56 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
     genForceTrajectory.resize(nt, Vector(nq));
     
     AnalysisSet& analysisSet = const_cast<AnalysisSet&>(getModel().getAnalysisSet());
-    //fill in results for each time
-    for(int i=0; i<nt; i++){ 
-        genForceTrajectory[i] = solve(s, Qs, times[i]);
-        analysisSet.step(s, i);
+
+    int nThreads = _numThreads>0 ? _numThreads :
+        (int)std::thread::hardware_concurrency();
+    if(nThreads > nt-1) nThreads = nt-1;
+
+    // Copies of the State share the Model, and a GeometryPath caches its
+    // wrapping in the Model itself, so enabled path forces (muscles,
+    // ligaments, path springs) require a serial solve.
+    const ForceSet& forceSet = getModel().getForceSet();
+    bool hasPathForces = false;
+    for(int i=0; i<forceSet.getSize() && !hasPathForces; i++)
+        hasPathForces = forceSet[i].hasGeometryPath() && !forceSet[i].isDisabled(s);
+
+    // Analyses are stepped in time order, so they require a serial solve
+    if(nThreads<=1 || analysisSet.getSize()>0 || hasPathForces) {
+        //fill in results for each time
+        for(int i=0; i<nt; i++){ 
+            genForceTrajectory[i] = solve(s, Qs, times[i]);
+            analysisSet.step(s, i);
+        }
+        return;
     }
+
+    // Functions, of the coordinates and of forces such as ExternalForce,
+    // create their underlying SimTK::Function on first use, so the first
+    // frame is solved serially before any of them are shared among threads.
+    genForceTrajectory[0] = solve(s, Qs, times[0]);
+
+    // Each frame is independent of the others, so contiguous blocks of the
+    // remaining frames are solved on separate threads with their own copy of
+    // the State. The last block is solved with s so that s ends at the last
+    // time.
+    int n = nt-1;
+    std::vector<SimTK::State> states(nThreads-1, s);
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto solveFrames = [&](SimTK::State& ks, int k) {
+        try {
+            for(int i=1+k*n/nThreads; i<1+(k+1)*n/nThreads; i++)
+                genForceTrajectory[i] = solve(ks, Qs, times[i]);
+        } catch(...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int k=0; k<nThreads-1; k++)
+        threads.push_back(std::thread(solveFrames, std::ref(states[k]), k));
+    solveFrames(s, nThreads-1);
+    for(size_t k=0; k<threads.size(); k++) threads[k].join();
+    for(int k=0; k<nThreads; k++)
+        if(errors[k]) std::rethrow_exception(errors[k]);
 }
 
 } // end of namespace OpenSim
\ No newline at end of file
@@ -57,6 +57,8 @@ OpenSim_DECLARE_CONCRETE_OBJECT(InverseDynamicsSolver, Solver);
 // MEMBER VARIABLES
 //=============================================================================
 protected:
+    /** Number of threads used to solve a trajectory (0 for all processors). */
+    int _numThreads;
 
 //=============================================================================
 // METHODS
@@ -67,6 +69,16 @@ public:
     //--------------------------------------------------------------------------
     /** Construct an InverseDynamics solver applied to the provided model */
     InverseDynamicsSolver(const Model& model);
+
+    /** Set the number of threads used to solve a trajectory of time frames.
+        A value of 0 uses as many threads as there are processors. The default
+        is 1. Frames are solved in parallel only when the model has no
+        analyses, since analyses must be stepped in time order, and no
+        enabled forces with a GeometryPath, since those update the shared
+        Model as they are computed. */
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
+    /** Get the number of threads used to solve a trajectory of time frames. */
+    int getNumThreads() const { return _numThreads; }
     
     /** Solve the inverse dynamics system of equations for generalized 
         coordinate forces, Tau. Applied loads are computed by the model  
@@ -93,7 +105,9 @@ public:
     virtual SimTK::Vector solve(SimTK::State& s, const FunctionSet& Qs, double time);
 #ifndef SWIG
     /** Same as above but for a given time series populate an Array (trajectory) of
-        generalized-coordinate forces (Vector) */
+        generalized-coordinate forces (Vector). Frames are divided among
+        getNumThreads() threads, each with its own copy of the State; the
+        State s is left at the last time. */
     virtual void solve(SimTK::State& s, const FunctionSet& Qs, 
                  const SimTK::Array_<double>&  times,
                  SimTK::Array_<SimTK::Vector>& genForceTrajectory);
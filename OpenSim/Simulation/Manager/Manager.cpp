@@ -56,6 +56,7 @@ Manager::~Manager()
 {
     // DESTRUCTORS
     delete _stateStore;
+    delete _stateWriter;
     _integ = NULL;
 }
 
@@ -138,6 +139,14 @@ setNull()
     _tArray.setSize(0);
     _system = 0;
     _dtArray.setSize(0);
+    _statesStreamFileName = "";
+    _controlsStreamFileName = "";
+    _streamChunkSize = StorageWriter::DEFAULT_CHUNK_SIZE;
+    _stateWriter = NULL;
+    _reportInterval = 0.0;
+    _reportDecimation = 1;
+    _lastRecordTime = -SimTK::Infinity;
+    _stepsSinceRecord = 0;
 }
 //_____________________________________________________________________________
 /**
@@ -675,6 +684,163 @@ hasStateStorage() const
     return (_stateStore != NULL);
 }
 
+//-----------------------------------------------------------------------------
+// STREAMING
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Set the names of the files to which the states and the controls are
+ * streamed during an integration.
+ *
+ * While streaming, recorded rows are written to the file by a background
+ * thread a chunk at a time (see StorageWriter) instead of being appended to
+ * the state storage or the control storage of the ControllerSet, so that
+ * memory use does not grow with the length of the simulation.  Those
+ * storages are left empty.  The files are rewritten by each integration and
+ * are complete once it returns.  A name ending in
+ * Storage::BINARY_FILE_EXTENSION selects the binary format.
+ *
+ * @param aStatesFileName File for the states; empty to store them in memory.
+ * @param aControlsFileName File for the controls; empty to store them in
+ * memory.
+ * @param aChunkSize Number of rows handed to the writing thread at a time.
+ */
+void Manager::
+setStreamFileNames(const string &aStatesFileName,
+    const string &aControlsFileName,int aChunkSize)
+{
+    _statesStreamFileName = aStatesFileName;
+    _controlsStreamFileName = aControlsFileName;
+    _streamChunkSize = aChunkSize;
+}
+//_____________________________________________________________________________
+/**
+ * Get the name of the file to which the states are streamed.
+ */
+const string& Manager::
+getStatesStreamFileName() const
+{
+    return(_statesStreamFileName);
+}
+//_____________________________________________________________________________
+/**
+ * Get the name of the file to which the controls are streamed.
+ */
+const string& Manager::
+getControlsStreamFileName() const
+{
+    return(_controlsStreamFileName);
+}
+//_____________________________________________________________________________
+/**
+ * Open the streams for an integration.
+ */
+void Manager::
+openStreams()
+{
+    closeStreams();
+    if(!_statesStreamFileName.empty())
+        _stateWriter = new StorageWriter(_statesStreamFileName,
+            getStateStorage(),_streamChunkSize);
+    if(!_controlsStreamFileName.empty() && _model->isControlled())
+        _controllerSet->openControlStream(_controlsStreamFileName,
+            _streamChunkSize);
+}
+//_____________________________________________________________________________
+/**
+ * Finish writing the streams of an integration.
+ */
+void Manager::
+closeStreams()
+{
+    if(_stateWriter!=NULL) {
+        _stateWriter->close();
+        delete _stateWriter;
+        _stateWriter = NULL;
+    }
+    if(!_controlsStreamFileName.empty() && _model->isControlled())
+        _controllerSet->closeControlStream();
+}
+
+//-----------------------------------------------------------------------------
+// REPORTING
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Set the minimum time between the steps at which states and controls are
+ * recorded.  The default of 0 records every reported integration step.
+ * The first and last steps of an integration, also of one that is halted,
+ * are always recorded.
+ */
+void Manager::
+setReportInterval(double aInterval)
+{
+    _reportInterval = (aInterval>0.0) ? aInterval : 0.0;
+}
+//_____________________________________________________________________________
+/**
+ * Get the minimum time between the steps at which states and controls are
+ * recorded.
+ */
+double Manager::
+getReportInterval() const
+{
+    return(_reportInterval);
+}
+//_____________________________________________________________________________
+/**
+ * Set the number of reported integration steps per recorded step; e.g.,
+ * with 10 only every tenth step is recorded.  The default of 1 records
+ * every step.  When a report interval is also set, a step is recorded only
+ * if it satisfies both.  The first and last steps of an integration are
+ * always recorded.
+ */
+void Manager::
+setReportDecimation(int aDecimation)
+{
+    _reportDecimation = (aDecimation>1) ? aDecimation : 1;
+}
+//_____________________________________________________________________________
+/**
+ * Get the number of reported integration steps per recorded step.
+ */
+int Manager::
+getReportDecimation() const
+{
+    return(_reportDecimation);
+}
+//_____________________________________________________________________________
+/**
+ * Record the states and the controls of an integration step, in memory or in
+ * the streams, subject to the report interval and decimation.
+ *
+ * @param s State of the step.
+ * @param step Step number.
+ * @param aForce Whether to record the step regardless of the report
+ * interval and decimation.
+ */
+void Manager::
+record(const SimTK::State& s, int step, bool aForce)
+{
+    double tReal = s.getTime();
+    _stepsSinceRecord++;
+    if(!aForce && (_stepsSinceRecord<_reportDecimation ||
+                   tReal<_lastRecordTime+_reportInterval)) return;
+    _stepsSinceRecord = 0;
+    _lastRecordTime = tReal;
+
+    SimTK::Vector stateValues = _model->getStateVariableValues(s);
+    if(_stateWriter!=NULL) {
+        _stateWriter->append(tReal, stateValues.size(), &stateValues[0]);
+    } else {
+        StateVector vec;
+        vec.setStates(tReal, stateValues.size(), &stateValues[0]);
+        getStateStorage().append(vec);
+    }
+    if(_model->isControlled())
+        _controllerSet->storeControls(s,step);
+}
+
 //-----------------------------------------------------------------------------
 // INTEGRATION
 //-----------------------------------------------------------------------------
@@ -705,7 +871,7 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
     // Halts must arrive during an integration.
     clearHalt();
 
-    double dt,dtPrev,tReal;
+    double dt,dtPrev;
     double time =_ti;
     dt=dtFirst;
     if(dt>_dtMax) dt = _dtMax;
@@ -770,15 +936,7 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
         sys.realize(s, SimTK::Stage::Acceleration);
 
         if(_performAnalyses)_model->updAnalysisSet().step(s, step);
-        tReal = s.getTime();
-        if( _writeToStorage ) {
-            SimTK::Vector stateValues = _model->getStateVariableValues(s);
-            StateVector vec;
-            vec.setStates(tReal, stateValues.size(), &stateValues[0]);
-            getStateStorage().append(vec);
-            if(_model->isControlled())
-                _controllerSet->storeControls(s,step);
-        }
+        if( _writeToStorage ) record(s, step, true);
     }
 
     double stepToTime = _tf;
@@ -801,15 +959,7 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
         if( status != SimTK::Integrator::EndOfSimulation ) {
             const SimTK::State& s =  _integ->getState();
             if(_performAnalyses)_model->updAnalysisSet().step(s,step);
-            tReal = s.getTime();
-            if( _writeToStorage) {
-                SimTK::Vector stateValues = _model->getStateVariableValues(s);
-                StateVector vec;
-                vec.setStates(tReal, stateValues.size(), &stateValues[0]);
-                getStateStorage().append(vec);
-                if(_model->isControlled())
-                    _controllerSet->storeControls(s, step);
-            }
+            if( _writeToStorage) record(s, step, s.getTime()>=_tf);
             step++;
         }
         else
@@ -819,6 +969,11 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
         // CHECK FOR INTERRUPT
         if(checkHalt()) break;
     }
+
+    // RECORD THE LAST STEP OF A HALTED INTEGRATION
+    if( _writeToStorage && _stepsSinceRecord>0 )
+        record(_integ->getState(), step-1, true);
+
     finalize(_integ->updAdvancedState() );
     s = _integ->getState();
 
@@ -852,6 +1007,11 @@ double Manager::getFixedStepSize(int tArrayStep) const {
  */
 void Manager::initialize(SimTK::State& s, double dt )
 {
+    // RECORDING
+    _lastRecordTime = s.getTime();
+    _stepsSinceRecord = 0;
+    if( _writeToStorage ) openStreams();
+
     // skip initailizations for CMC's actutator system
     if( _writeToStorage && _performAnalyses ) { 
 
@@ -864,7 +1024,10 @@ void Manager::initialize(SimTK::State& s, double dt )
         }
 
         // STORE STARTING STATES
-        if(hasStateStorage()) {
+        if(_stateWriter!=NULL) {
+            SimTK::Vector stateValues = _model->getStateVariableValues(s);
+            _stateWriter->append(tReal,stateValues.size(), &stateValues[0]);
+        } else if(hasStateStorage()) {
             // ONLY IF NO STATES WERE PREVIOUSLY STORED
             if(getStateStorage().getSize()==0) {
                 SimTK::Vector stateValues = _model->getStateVariableValues(s);
@@ -887,6 +1050,9 @@ void Manager::initialize(SimTK::State& s, double dt )
  */
 void Manager::finalize(SimTK::State& s )
 {
+    // STREAMS
+    closeStreams();
+
         // ANALYSES 
     if(  _performAnalyses ) { 
         AnalysisSet& analysisSet = _model->updAnalysisSet();
@@ -30,6 +30,7 @@
 
 // INCLUDES
 #include <OpenSim/Common/Object.h>
+#include <OpenSim/Common/StorageWriter.h>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include "SimTKsimbody.h"
 
@@ -70,6 +71,25 @@ private:
     /** Storage for the states. */
     Storage *_stateStore;
 
+    /** Names of the files to which states and controls are streamed during
+    an integration instead of being stored in memory; empty for no
+    streaming. */
+    std::string _statesStreamFileName;
+    std::string _controlsStreamFileName;
+    /** Number of rows handed to the writing thread of a stream at a time. */
+    int _streamChunkSize;
+    /** Writer of the states stream during an integration. */
+    StorageWriter *_stateWriter;
+
+    /** Minimum time between recorded states and controls. */
+    double _reportInterval;
+    /** Number of reported integration steps per recorded step. */
+    int _reportDecimation;
+    /** Time of the last recorded step. */
+    double _lastRecordTime;
+    /** Number of reported integration steps since the last recorded step. */
+    int _stepsSinceRecord;
+
    int _steps;
    /** Number of integration step trys. */
    int _trys;
@@ -191,6 +211,24 @@ public:
     void setStateStorage(Storage& aStorage);
     Storage& getStateStorage() const;
 
+    // STREAMING
+    void setStreamFileNames(const std::string &aStatesFileName,
+        const std::string &aControlsFileName="",
+        int aChunkSize=StorageWriter::DEFAULT_CHUNK_SIZE);
+    const std::string& getStatesStreamFileName() const;
+    const std::string& getControlsStreamFileName() const;
+
+    // REPORTING
+    void setReportInterval(double aInterval);
+    double getReportInterval() const;
+    void setReportDecimation(int aDecimation);
+    int getReportDecimation() const;
+private:
+    void openStreams();
+    void closeStreams();
+    void record(const SimTK::State& s, int step, bool aForce);
+public:
+
    //--------------------------------------------------------------------------
    //  INTERRUPT
    //--------------------------------------------------------------------------
@@ -164,6 +164,7 @@ public:
     // Convenience Access
     //--------------------------------------------------------------------------
     double getSamplingFrequency() {return _markerData->getDataRate(); }
+    const MarkerData& getMarkerData() const {return *_markerData; }
     Set<MarkerWeight> &updMarkerWeightSet() {return _markerWeightSet; }
     void setMarkerWeightSet(Set<MarkerWeight> &markerWeights);
     void setDefaultWeight(double weight) {_defaultWeight = weight; }
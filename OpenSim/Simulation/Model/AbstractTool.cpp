@@ -61,6 +61,7 @@ AbstractTool::AbstractTool():
     _forceSetFiles(_forceSetFilesProp.getValueStrArray()),
     _resultsDir(_resultsDirProp.getValueStr()),
     _outputPrecision(_outputPrecisionProp.getValueInt()),
+    _writeBinaryResults(_writeBinaryResultsProp.getValueBool()),
     _ti(_tiProp.getValueDbl()),
     _tf(_tfProp.getValueDbl()),
     _solveForEquilibriumForAuxiliaryStates(_solveForEquilibriumForAuxiliaryStatesProp.getValueBool()),
@@ -93,6 +94,7 @@ AbstractTool::AbstractTool(const string &aFileName, bool aUpdateFromXMLNode):
     _forceSetFiles(_forceSetFilesProp.getValueStrArray()),
     _resultsDir(_resultsDirProp.getValueStr()),
     _outputPrecision(_outputPrecisionProp.getValueInt()),
+    _writeBinaryResults(_writeBinaryResultsProp.getValueBool()),
     _ti(_tiProp.getValueDbl()),
     _tf(_tfProp.getValueDbl()),
     _solveForEquilibriumForAuxiliaryStates(_solveForEquilibriumForAuxiliaryStatesProp.getValueBool()),
@@ -155,6 +157,7 @@ AbstractTool::AbstractTool(const AbstractTool &aTool):
     _forceSetFiles(_forceSetFilesProp.getValueStrArray()),
     _resultsDir(_resultsDirProp.getValueStr()),
     _outputPrecision(_outputPrecisionProp.getValueInt()),
+    _writeBinaryResults(_writeBinaryResultsProp.getValueBool()),
     _ti(_tiProp.getValueDbl()),
     _tf(_tfProp.getValueDbl()),
     _solveForEquilibriumForAuxiliaryStates(_solveForEquilibriumForAuxiliaryStatesProp.getValueBool()),
@@ -188,6 +191,7 @@ setNull()
     _replaceForceSet = true;
     _resultsDir = "./";
     _outputPrecision = 8;
+    _writeBinaryResults = false;
     _ti = 0.0;
     _tf = 1.0;
     _solveForEquilibriumForAuxiliaryStates = false;
@@ -233,6 +237,12 @@ void AbstractTool::setupProperties()
     _outputPrecisionProp.setName("output_precision");
     _propertySet.append( &_outputPrecisionProp );
 
+    comment = "Write results in the binary storage format (.stob) instead of as text (.sto). "
+                "Binary files are much faster to write and read.  It is false by default.";
+    _writeBinaryResultsProp.setComment(comment);
+    _writeBinaryResultsProp.setName("write_binary_results");
+    _propertySet.append( &_writeBinaryResultsProp );
+
     comment = "Initial time for the simulation.";
     _tiProp.setComment(comment);
     _tiProp.setName("initial_time");
@@ -309,6 +319,7 @@ operator=(const AbstractTool &aTool)
     _resultsDir = aTool._resultsDir;
 
     _outputPrecision = aTool._outputPrecision;
+    _writeBinaryResults = aTool._writeBinaryResults;
     _ti = aTool._ti;
     _tf = aTool._tf;
     _solveForEquilibriumForAuxiliaryStates = aTool._solveForEquilibriumForAuxiliaryStates;
@@ -551,7 +562,17 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
 {
     cout<<"Printing results of investigation "<<getName()<<" to "<<aDir<<"."<<endl;
     IO::makeDir(aDir);
-    _model->updAnalysisSet().printResults(aBaseName,aDir,aDT,aExtension);
+    const string extension = (aExtension==".sto") ? getResultsFileExtension() : aExtension;
+    _model->updAnalysisSet().printResults(aBaseName,aDir,aDT,extension);
+}
+//_____________________________________________________________________________
+/**
+ * Get the extension of the results files written by this tool.
+ */
+string AbstractTool::
+getResultsFileExtension() const
+{
+    return _writeBinaryResults ? Storage::BINARY_FILE_EXTENSION : ".sto";
 }
 
 
@@ -86,6 +86,11 @@ protected:
     /** Output precision. */
     PropertyInt _outputPrecisionProp;
     int &_outputPrecision;
+
+    /** Whether results are written in the binary storage format (.stob)
+    instead of as text (.sto). */
+    PropertyBool _writeBinaryResultsProp;
+    bool &_writeBinaryResults;
     
     /** Initial time for the investigation. */
     PropertyDbl _tiProp;
@@ -273,6 +278,12 @@ public:
     int getOutputPrecision() const { return _outputPrecision; }
     void setOutputPrecision(int aPrecision) { _outputPrecision = aPrecision; }
 
+    bool getWriteBinaryResults() const { return _writeBinaryResults; }
+    void setWriteBinaryResults(bool aTrueFalse) { _writeBinaryResults = aTrueFalse; }
+    /** Extension of the results files written by this tool, ".sto", or
+    Storage::BINARY_FILE_EXTENSION when writing binary results. */
+    std::string getResultsFileExtension() const;
+
     AnalysisSet& getAnalysisSet() const;
 
     /** 
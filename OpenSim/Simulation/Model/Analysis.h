@@ -209,6 +209,14 @@ public:
     void setStorageInterval(int aInterval);
     int getStorageInterval() const;
 #endif
+    /**
+     * Get the storages in which the analysis records its results.  An
+     * analysis must list every storage to which it appends rows, by the time
+     * begin() returns, for its results to be complete when the frames are
+     * analyzed on several threads (see AnalyzeTool::run()).  If it lists
+     * none, the frames are analyzed on one thread.  Results kept other than
+     * as rows of these storages are not merged.
+     */
     virtual ArrayPtrs<Storage>& getStorageList();
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
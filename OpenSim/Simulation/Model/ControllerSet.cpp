@@ -189,8 +189,12 @@ void ControllerSet::storeControls( const SimTK::State& s, int step  )
     
     if( size > 0 )
     {
-        _controlStore->store( step, s.getTime(), getModel().getNumControls(), 
-                              &(getModel().getControls(s)[0]) );
+        if( _controlWriter )
+            _controlWriter->append( s.getTime(), getModel().getNumControls(),
+                                    &(getModel().getControls(s)[0]) );
+        else
+            _controlStore->store( step, s.getTime(), getModel().getNumControls(), 
+                                  &(getModel().getControls(s)[0]) );
     }
 }
 
@@ -200,6 +204,25 @@ void ControllerSet::printControlStorage( const string& fileName)  const
    _controlStore->print(fileName);
 }
 
+// write the controls stored from now on directly to a file instead of keeping
+// them in the control storage, until closeControlStream() is called
+void ControllerSet::openControlStream( const string& fileName, int chunkSize )
+{
+    closeControlStream();
+    if( !_controlStore )
+        throw Exception("ControllerSet::openControlStream: actuators are not set");
+    _controlWriter.reset(new StorageWriter(fileName, *_controlStore, chunkSize));
+}
+
+// finish writing the control stream, if one is open
+bool ControllerSet::closeControlStream()
+{
+    if( !_controlWriter ) return true;
+    bool success = _controlWriter->close();
+    _controlWriter.reset();
+    return success;
+}
+
 void ControllerSet::setActuators( Set<Actuator>& as) 
 {
     _actuatorSet = &as;
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <OpenSim/Simulation/Control/Controller.h>
 #include <OpenSim/Simulation/Model/ModelComponentSet.h>
+#include <OpenSim/Common/StorageWriter.h>
 #include "SimTKsimbody.h"
 
 #include <memory>
@@ -85,6 +86,9 @@ public:
     void constructStorage();
     void storeControls( const SimTK::State& s, int step );
     void printControlStorage( const std::string& fileName) const;
+    void openControlStream( const std::string& fileName,
+        int chunkSize=StorageWriter::DEFAULT_CHUNK_SIZE);
+    bool closeControlStream();
     void setActuators(Set<Actuator>& actuators);
 
     void setDesiredStates( Storage* yStore); 
@@ -98,6 +102,10 @@ private:
 
     std::unique_ptr<Storage> _controlStore;
 
+    // Writer that receives the stored controls instead of _controlStore
+    // while a control stream is open.
+    std::unique_ptr<StorageWriter> _controlWriter;
+
     // Set of actuators controlled by the set of controllers.
     SimTK::ReferencePtr<Set<Actuator> > _actuatorSet;
 //=============================================================================
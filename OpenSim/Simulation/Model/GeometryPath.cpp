@@ -38,6 +38,8 @@
 #include "Model.h"
 
 #include "ModelVisualizer.h"
+
+#include <mutex>
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -48,6 +50,14 @@ using SimTK::Vec3;
 
 static const Vec3 DefaultDefaultColor(.5,.5,.5); // boring gray 
 
+// A coordinate is spanned by a path if moving it over its range changes the
+// path length by more than this (m).
+static const double SurrogateSpanTolerance = 1e-8;
+// Surrogates with more terms than this are too costly to fit.
+static const int MaxSurrogateTerms = 1000;
+// Step (rad or m) of the central differences that check surrogate moment arms.
+static const double SurrogateCheckStep = 1e-5;
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -89,6 +99,8 @@ void GeometryPath::extendConnectToModel(Model& aModel)
         upd_PathPointSet().get(i).connectToModelAndPath(aModel, *this);
     }
 
+    // A surrogate fitted to a previous model or path is no longer valid.
+    _surrogate.reset();
 }
 
 //_____________________________________________________________________________
@@ -102,26 +114,30 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // Allocate cache entries to save the current length and speed(=d/dt length)
     // of the path in the cache. Length depends only on q's so will be valid
     // after Position stage, speed requires u's also so valid at Velocity stage.
-    addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
-    addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
+    _lengthCV = addCacheVariable<double>("length", 0.0, SimTK::Stage::Position);
+    _speedCV = addCacheVariable<double>("speed", 0.0, SimTK::Stage::Velocity);
     // Cache the set of points currently defining this path.
     Array<PathPoint *> pathPrototype;
-    addCacheVariable<Array<PathPoint *> >
+    _currentPathCV = addCacheVariable<Array<PathPoint *> >
         ("current_path", pathPrototype, SimTK::Stage::Position);
     // When displaying, cache the set of points to be used to draw the path.
-    addCacheVariable<Array<PathPoint *> >
+    _currentDisplayPathCV = addCacheVariable<Array<PathPoint *> >
         ("current_display_path", pathPrototype, SimTK::Stage::Position);
 
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
-    addCacheVariable<SimTK::Vec3>("color", get_default_color(), 
-                                  SimTK::Stage::Topology);
+    _colorCV = addCacheVariable<SimTK::Vec3>("color", get_default_color(), 
+                                             SimTK::Stage::Topology);
+    // Likewise for the wrap cache, which only ever holds the last wrapping.
+    _wrapCacheCV = addCacheVariable<WrapCache>("wrap_cache", WrapCache(),
+                                               SimTK::Stage::Topology);
 }
 
  void GeometryPath::extendInitStateFromProperties(SimTK::State& s) const
 {
     Super::extendInitStateFromProperties(s);
-    markCacheVariableValid(s, "color"); // it is OK at its default value
+    markCacheVariableValid(s, _colorCV); // it is OK at its default value
+    markCacheVariableValid(s, _wrapCacheCV);
 }
 
 //------------------------------------------------------------------------------
@@ -195,6 +211,8 @@ void GeometryPath::constructProperties()
     
     Vec3 defaultColor = SimTK::White;
     constructProperty_default_color(defaultColor);
+
+    constructProperty_surrogate_polynomial_order(0);
 }
 
 //_____________________________________________________________________________
@@ -228,7 +246,7 @@ const OpenSim::Array <PathPoint*> & GeometryPath::
 getCurrentPath(const SimTK::State& s)  const
 {
     computePath(s);   // compute checks if path needs to be recomputed
-    return getCacheVariableValue< Array<PathPoint*> >(s, "current_path");
+    return getCacheVariableValue(s, _currentPathCV);
 }
 
 // get the the path as PointForceDirections directions 
@@ -305,6 +323,21 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
     SimTK::Vector& mobilityForces) const
 {
+    if (std::shared_ptr<const PathSurrogate> surrogate = useSurrogate(s)) {
+        // The generalized force of a tension along the path is the tension
+        // times the negative derivative of the length.
+        double dLdq[PathSurrogate::MaxCoordinates];
+        surrogate->calcLength(s, dLdq);
+        for (int i = 0; i < surrogate->getNumCoordinates(); ++i) {
+            const Coordinate& coord = surrogate->getCoordinate(i);
+            getModel().getMatterSubsystem()
+                .getMobilizedBody(coord.getBodyIndex())
+                .applyOneMobilityForce(s, coord.getMobilizerQIndex(),
+                                       -tension*dLdq[i], mobilityForces);
+        }
+        return;
+    }
+
     PathPoint* start = NULL;
     PathPoint* end = NULL;
     const SimTK::MobilizedBody* bo = NULL;
@@ -411,7 +444,7 @@ getCurrentDisplayPath(const SimTK::State& s) const
 {
     // update the geometry to make sure the current display path is up to date.
     // updateGeometry(s);
-    return getCacheVariableValue<Array <PathPoint*> >(s, "current_display_path" );
+    return getCacheVariableValue(s, _currentDisplayPathCV);
 }
 
 //_____________________________________________________________________________
@@ -428,7 +461,7 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
     computePath(s);
 
     // If display path is current do not need to recompute it.
-    if (isCacheVariableValid(s, "current_display_path"))
+    if (isCacheVariableValid(s, _currentDisplayPathCV))
         return;
    
     // Updating the display path will also validate the current_display_path 
@@ -450,23 +483,29 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
  */
 double GeometryPath::getLength( const SimTK::State& s) const
 {
+    if (std::shared_ptr<const PathSurrogate> surrogate = useSurrogate(s)) {
+        if (!isCacheVariableValid(s, _lengthCV))
+            setLength(s, surrogate->calcLength(s));
+        return getCacheVariableValue(s, _lengthCV);
+    }
+
     computePath(s);  // compute checks if path needs to be recomputed
-    return( getCacheVariableValue<double>(s, "length") );
+    return( getCacheVariableValue(s, _lengthCV) );
 }
 
 void GeometryPath::setLength( const SimTK::State& s, double length ) const
 {
-    setCacheVariableValue<double>(s, "length", length); 
+    setCacheVariableValue(s, _lengthCV, length); 
 }
 
 void GeometryPath::setColor(const SimTK::State& s, const SimTK::Vec3& color) const
 {
-    setCacheVariableValue<SimTK::Vec3>(s, "color", color);
+    setCacheVariableValue(s, _colorCV, color);
 }
 
 Vec3 GeometryPath::getColor(const SimTK::State& s) const
 {
-    return getCacheVariableValue<SimTK::Vec3>(s, "color");
+    return getCacheVariableValue(s, _colorCV);
 }
 
 //_____________________________________________________________________________
@@ -478,11 +517,11 @@ Vec3 GeometryPath::getColor(const SimTK::State& s) const
 double GeometryPath::getLengtheningSpeed( const SimTK::State& s) const
 {
     computeLengtheningSpeed(s);
-    return getCacheVariableValue<double>(s, "speed");
+    return getCacheVariableValue(s, _speedCV);
 }
 void GeometryPath::setLengtheningSpeed( const SimTK::State& s, double speed ) const
 {
-    setCacheVariableValue<double>(s, "speed", speed);    
+    setCacheVariableValue(s, _speedCV, speed);    
 }
 
 void GeometryPath::setPreScaleLength( const SimTK::State& s, double length ) {
@@ -835,6 +874,9 @@ void GeometryPath::scale(const SimTK::State& s, const ScaleSet& aScaleSet)
  */
 void GeometryPath::postScale(const SimTK::State& s, const ScaleSet& aScaleSet)
 {
+    // The surrogate was fitted to the unscaled path.
+    _surrogate.reset();
+
     // Recalculate the path. This will also update the geometry.
     // Done here since scale is invoked before bodies are scaled
     // so we may not have enough info to update (e.g. wrapping, via points)
@@ -855,13 +897,13 @@ void GeometryPath::computePath(const SimTK::State& s) const
 {
     const SimTK::Stage& sg = s.getSystemStage();
     
-    if (isCacheVariableValid(s, "current_path"))  {
+    if (isCacheVariableValid(s, _currentPathCV))  {
         return;
     }
 
     // Clear the current path.
     Array<PathPoint*>& currentPath = 
-        updCacheVariableValue<Array<PathPoint*> >(s, "current_path");
+        updCacheVariableValue(s, _currentPathCV);
     currentPath.setSize(0);
 
     // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -882,9 +924,12 @@ void GeometryPath::computePath(const SimTK::State& s) const
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
     applyWrapObjects(s, currentPath);
-    calcLengthAfterPathComputation(s, currentPath);
+    const double length = calcLengthAfterPathComputation(s, currentPath);
+    // With a surrogate, the length is the surrogate's.
+    if (!hasSurrogate())
+        setLength(s, length);
 
-    markCacheVariableValid(s, "current_path");
+    markCacheVariableValid(s, _currentPathCV);
 }
 
 //_____________________________________________________________________________
@@ -893,9 +938,19 @@ void GeometryPath::computePath(const SimTK::State& s) const
  */
 void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
 {
-    if (isCacheVariableValid(s, "speed"))
+    if (isCacheVariableValid(s, _speedCV))
         return;
 
+    if (std::shared_ptr<const PathSurrogate> surrogate = useSurrogate(s)) {
+        double dLdq[PathSurrogate::MaxCoordinates];
+        surrogate->calcLength(s, dLdq);
+        double speed = 0.0;
+        for (int i = 0; i < surrogate->getNumCoordinates(); ++i)
+            speed += dLdq[i]*surrogate->getCoordinate(i).getSpeedValue(s);
+        setLengtheningSpeed(s, speed);
+        return;
+    }
+
     SimTK::Vec3 posRelative, velRelative;
     SimTK::Vec3 posStartInertial, posEndInertial, 
                 velStartInertial, velEndInertial;
@@ -961,18 +1016,35 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
 void GeometryPath::
 applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const 
 {
-    if (get_PathWrapSet().getSize() < 1)
+    const int nw = get_PathWrapSet().getSize();
+    if (nw < 1)
         return;
 
+    // The last wrapping of this path in this state. Before the first one,
+    // the order is the order the objects are listed in the path.
+    WrapCache& cache = updCacheVariableValue(s, _wrapCacheCV);
+    if (cache.order.getSize() != nw) {
+        cache = WrapCache();
+        cache.order.setSize(nw);
+        cache.result.setSize(nw);
+        for (int i = 0; i < nw; i++) {
+            cache.order[i] = i;
+            get_PathWrapSet().get(i).resetPreviousWrap();
+            cache.previousWrap.push_back(
+                get_PathWrapSet().get(i).getPreviousWrap());
+        }
+        cache.segmentStart.assign(nw, NULL);
+        cache.segmentEnd.assign(nw, NULL);
+    }
+
     WrapResult best_wrap;
     Array<int> result, order;
+    std::vector<const PathPoint*> segmentStart(nw), segmentEnd(nw);
+    // range of path points each object may wrap (-1 if it is not active)
+    std::vector<int> rangeStart(nw), rangeEnd(nw);
 
-    result.setSize(get_PathWrapSet().getSize());
-    order.setSize(get_PathWrapSet().getSize());
-
-    // Set the initial order to be the order they are listed in the path.
-    for (int i = 0; i < get_PathWrapSet().getSize(); i++)
-        order[i] = i;
+    result.setSize(nw);
+    order = cache.order;
 
     // If there is only one wrap object, calculate the wrapping only once.
     // If there are two or more objects, perform up to 8 iterations where
@@ -988,6 +1060,11 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
             PathWrap& ws = get_PathWrapSet().get(order[i]);
             const WrapObject* wo = ws.getWrapObject();
             best_wrap.wrap_pts.setSize(0);
+            segmentStart[i] = segmentEnd[i] = NULL;
+            rangeStart[i] = rangeEnd[i] = -1;
+
+            // Seed the wrap with its last result in this state.
+            ws.setPreviousWrap(cache.previousWrap[order[i]]);
             double min_length_change = SimTK::Infinity;
 
             // First remove this object's wrapping points from the current path.
@@ -1020,6 +1097,8 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
                 const int wrapEnd   = (ws.getEndPoint() < 1
                                             ? get_PathPointSet().getSize() - 1 
                                             : ws.getEndPoint() - 1);
+                rangeStart[i] = wrapStart;
+                rangeEnd[i] = wrapEnd;
 
                 // 2. Scan forward from wrapStart in get_PathPointSet() to find 
                 // the first point that is active. Store a pointer to it (smp).
@@ -1145,11 +1224,50 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
                     ws.getWrapPoint(0).setLocation(s,best_wrap.r1);
                     ws.getWrapPoint(1).setLocation(s,best_wrap.r2);
 
+                    segmentStart[i] = path.get(best_wrap.startPoint);
+                    segmentEnd[i] = path.get(best_wrap.endPoint);
+
                     // Now insert the two new wrapping points into mp[] array.
                     path.insert(best_wrap.endPoint, &ws.getWrapPoint(0));
                     path.insert(best_wrap.endPoint + 1, &ws.getWrapPoint(1));
                 }
             }
+            cache.previousWrap[order[i]] = ws.getPreviousWrap();
+        }
+
+        // Wrap objects that wrap segments which do not end on another
+        // object's tangent points do not affect one another. If they also
+        // wrapped the same segments, with the same outcomes, the last time
+        // this path was wrapped in this state (in the order it started
+        // with), a second pass would only repeat the first, provided that
+        // no object, wrapped or not, would see a new segment in its range
+        // in the second pass. That happens if an object applied after it
+        // in the first pass wrapped a segment inside that range.
+        if (kk == 0 && cache.valid && maxIterations > 1) {
+            bool repeat = true;
+            for (int i = 0; i < nw && repeat; i++) {
+                const int w = order[i];
+                repeat =    result[i] == cache.result[w]
+                         && segmentStart[i] == cache.segmentStart[w]
+                         && segmentEnd[i] == cache.segmentEnd[w]
+                         && (   segmentStart[i] == NULL
+                             || (   segmentStart[i]->getWrapObject() == NULL
+                                 && segmentEnd[i]->getWrapObject() == NULL));
+            }
+            for (int i = 0; i < nw && repeat; i++) {
+                if (rangeStart[i] < 0)
+                    continue;
+                for (int j = i + 1; j < nw && repeat; j++) {
+                    if (segmentStart[j] == NULL)
+                        continue;
+                    const int first = get_PathPointSet().getIndex(segmentStart[j]);
+                    const int last = get_PathPointSet().getIndex(segmentEnd[j]);
+                    repeat =    first >= 0 && last >= 0
+                             && (last <= rangeStart[i] || first >= rangeEnd[i]);
+                }
+            }
+            if (repeat)
+                break;
         }
 
         const double length = calcLengthAfterPathComputation(s, path); 
@@ -1181,6 +1299,16 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
             }
         }
     }
+
+    // Remember how the path was wrapped for the next time.
+    for (int i = 0; i < nw; i++) {
+        const int w = order[i];
+        cache.order[i] = w;
+        cache.result[w] = result[i];
+        cache.segmentStart[w] = segmentStart[i];
+        cache.segmentEnd[w] = segmentEnd[i];
+    }
+    cache.valid = true;
 }
 
 //_____________________________________________________________________________
@@ -1244,7 +1372,6 @@ calcLengthAfterPathComputation(const SimTK::State& s,
         }
     }
 
-    setLength(s,length);
     return( length );
 }
 
@@ -1263,6 +1390,233 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
     return _maSolver->solve(s, aCoord,  *this);
 }
 
+//=============================================================================
+// SURROGATE
+//=============================================================================
+//_____________________________________________________________________________
+/*
+ * The surrogate to use, fitting it first if it has not been; NULL if the
+ * exact path is to be used. The thread fitting the surrogate uses the exact
+ * path, and other threads wait for the fit.
+ */
+std::shared_ptr<const PathSurrogate>
+GeometryPath::useSurrogate(const SimTK::State& s) const
+{
+    std::shared_ptr<const PathSurrogate> surrogate;
+    if (get_surrogate_polynomial_order() <= 0)
+        return surrogate;
+
+    surrogate = _surrogate.get();
+    if (!surrogate) {
+        if (_surrogate.fittingThread == std::this_thread::get_id())
+            return surrogate;
+        std::lock_guard<std::recursive_mutex> lock(_surrogate.mutex);
+        surrogate = _surrogate.get();
+        if (!surrogate) {
+            fitSurrogate(s);
+            surrogate = _surrogate.get();
+        }
+    }
+    if (surrogate && !surrogate->isValid())
+        surrogate.reset();
+    return surrogate;
+}
+
+//_____________________________________________________________________________
+/*
+ * Fit the surrogate to the exact length, sampled in a copy of the state.
+ * Coordinates are set directly, without enforcing constraints or locks, since
+ * the surrogate is a function of each spanned coordinate independently.
+ */
+void GeometryPath::fitSurrogate(const SimTK::State& s) const
+{
+    std::lock_guard<std::recursive_mutex> lock(_surrogate.mutex);
+    _surrogate.reset();
+
+    const int order = get_surrogate_polynomial_order();
+    if (order <= 0)
+        return;
+    if (order > PathSurrogate::MaxOrder)
+        throw Exception("GeometryPath: surrogate_polynomial_order exceeds "
+                        "PathSurrogate::MaxOrder.",__FILE__,__LINE__);
+
+    const std::string& name = _owner ? _owner->getName() : getName();
+    const SimTK::MultibodySystem& system = getModel().getMultibodySystem();
+    const SimTK::SimbodyMatterSubsystem& matter =
+                                        getModel().getMatterSubsystem();
+    const CoordinateSet& coordinates = getModel().getCoordinateSet();
+
+    _surrogate.fittingThread = std::this_thread::get_id();
+    PathSurrogate* surrogate = NULL;
+    try {
+        SimTK::State sample = s;
+        auto setQ = [&](const Coordinate& coord, double q) {
+            matter.getMobilizedBody(coord.getBodyIndex())
+                .setOneQ(sample, coord.getMobilizerQIndex(), q);
+        };
+        auto sampleLength = [&]() {
+            system.realize(sample, SimTK::Stage::Position);
+            return computeExactLength(sample);
+        };
+
+        // Find the coordinates the path spans by moving each one across the
+        // interval it will be sampled over.
+        Array<const Coordinate*> spanned;
+        std::vector<double> lower, upper;
+        bool usable = true;
+        const double length0 = sampleLength();
+        for (int j = 0; j < coordinates.getSize() && usable; ++j) {
+            const Coordinate& coord = coordinates[j];
+            double lo = coord.getRangeMin();
+            double hi = coord.getRangeMax();
+            if (coord.getMotionType() == Coordinate::Rotational) {
+                lo = std::max(lo, -SimTK::Pi);
+                hi = std::min(hi, SimTK::Pi);
+            }
+            if (!SimTK::isFinite(lo) || !SimTK::isFinite(hi) || hi <= lo)
+                continue;
+
+            const double q0 = coord.getValue(sample);
+            bool spans = false;
+            for (int k = 0; k <= 4 && !spans; ++k) {
+                setQ(coord, lo + 0.25*k*(hi - lo));
+                spans = std::abs(sampleLength() - length0)
+                        > SurrogateSpanTolerance;
+            }
+            setQ(coord, q0);
+            if (!spans)
+                continue;
+
+            // The speed of the coordinate must be its time derivative for
+            // the lengthening speed and forces to follow from the gradient.
+            const SimTK::MobilizedBody& mobod =
+                matter.getMobilizedBody(coord.getBodyIndex());
+            sample.updU() = 0;
+            mobod.setOneU(sample, coord.getMobilizerQIndex(), 1.0);
+            system.realize(sample, SimTK::Stage::Velocity);
+            SimTK::Vector qdot = mobod.getQDotAsVector(sample);
+            sample.updU() = s.getU();
+            if (qdot.size() != mobod.getNumU(sample)) {
+                usable = false;
+                break;
+            }
+            qdot[coord.getMobilizerQIndex()] -= 1.0;
+            usable = qdot.normInf() <= SimTK::SignificantReal;
+
+            spanned.append(&coord);
+            lower.push_back(lo);
+            upper.push_back(hi);
+            usable = usable && spanned.getSize() <= PathSurrogate::MaxCoordinates;
+        }
+
+        if (usable) {
+            surrogate = new PathSurrogate(spanned, lower, upper, order);
+            usable = surrogate->getNumTerms() <= MaxSurrogateTerms;
+        }
+        if (!usable) {
+            cout << "GeometryPath: WARN- cannot fit a surrogate to the path of '"
+                 << name << "' (too many coordinates, too many terms, or a "
+                 << "coordinate whose speed is not its derivative). "
+                 << "Using the exact path." << endl;
+            delete surrogate;
+            surrogate = new PathSurrogate();
+        } else {
+            const int nc = spanned.getSize();
+            const int nTerms = surrogate->getNumTerms();
+            SimTK::Random::Uniform random(0.0, 1.0);
+            random.setSeed(nc + 10*order);
+            double q[PathSurrogate::MaxCoordinates];
+            auto setRandomQ = [&]() {
+                for (int i = 0; i < nc; ++i) {
+                    q[i] = lower[i] + (upper[i] - lower[i])*random.getValue();
+                    setQ(*spanned[i], q[i]);
+                }
+            };
+
+            // Fit to three samples per term.
+            const int nFit = 3*nTerms;
+            SimTK::Matrix qFit(nFit, nc);
+            SimTK::Vector lengths(nFit);
+            for (int r = 0; r < nFit; ++r) {
+                setRandomQ();
+                for (int i = 0; i < nc; ++i)
+                    qFit(r, i) = q[i];
+                lengths[r] = sampleLength();
+            }
+            surrogate->fit(qFit, lengths);
+
+            // Check on new samples, moment arms against central differences
+            // of the exact length.
+            double dLdq[PathSurrogate::MaxCoordinates];
+            double maxLengthError = 0.0, maxMomentArmError = 0.0;
+            const int nCheck = std::max(nTerms, 20);
+            for (int r = 0; r < nCheck; ++r) {
+                setRandomQ();
+                const double length = surrogate->calcLength(q, dLdq);
+                maxLengthError = std::max(maxLengthError,
+                                          std::abs(length - sampleLength()));
+                for (int i = 0; i < nc; ++i) {
+                    setQ(*spanned[i], q[i] + SurrogateCheckStep);
+                    const double lengthPlus = sampleLength();
+                    setQ(*spanned[i], q[i] - SurrogateCheckStep);
+                    const double lengthMinus = sampleLength();
+                    setQ(*spanned[i], q[i]);
+                    const double dLdqExact = (lengthPlus - lengthMinus)
+                                             /(2*SurrogateCheckStep);
+                    maxMomentArmError = std::max(maxMomentArmError,
+                                                 std::abs(dLdq[i] - dLdqExact));
+                }
+            }
+            surrogate->setAccuracy(maxLengthError, maxMomentArmError);
+        }
+    }
+    catch (...) {
+        delete surrogate;
+        _surrogate.fittingThread = std::thread::id();
+        throw;
+    }
+    _surrogate.fittingThread = std::thread::id();
+    _surrogate.reset(surrogate);
+
+    // Sampling moved the path's points and wrap results, and the length and
+    // speed in the given state may have come from the exact path.
+    markCacheVariableInvalid(s, _currentPathCV);
+    markCacheVariableInvalid(s, _lengthCV);
+    markCacheVariableInvalid(s, _speedCV);
+}
+
+//_____________________________________________________________________________
+/*
+ * Whether a valid surrogate has been fitted.
+ */
+bool GeometryPath::hasSurrogate() const
+{
+    std::shared_ptr<const PathSurrogate> surrogate = _surrogate.get();
+    return surrogate && surrogate->isValid();
+}
+
+//_____________________________________________________________________________
+/*
+ * Get the fitted surrogate.
+ */
+const PathSurrogate& GeometryPath::getSurrogate() const
+{
+    if (!hasSurrogate())
+        throw Exception("GeometryPath::getSurrogate: the path of '"
+            + (_owner ? _owner->getName() : getName())
+            + "' has no fitted surrogate.",__FILE__,__LINE__);
+    return *_surrogate.get();
+}
+
+//_____________________________________________________________________________
+/*
+ * Compute the length from the path points and wrap objects.
+ */
+double GeometryPath::computeExactLength(const SimTK::State& s) const
+{
+    return calcLengthAfterPathComputation(s, getCurrentPath(s));
+}
+
 //_____________________________________________________________________________
 /*
  * Update the cache entry for current_display_path
@@ -1270,7 +1624,7 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
 void GeometryPath::updateDisplayPath(const SimTK::State& s) const
 {
     Array<PathPoint*>& currentDisplayPath = 
-        updCacheVariableValue<Array<PathPoint*> >(s, "current_display_path");
+        updCacheVariableValue(s, _currentDisplayPathCV);
     // Clear the current display path. Delete all path points
     // that have a NULL path pointer. This means that they were
     // created by an earlier call to updateDisplayPath() and are
@@ -1285,7 +1639,7 @@ void GeometryPath::updateDisplayPath(const SimTK::State& s) const
     currentDisplayPath.setSize(0);
 
     const Array<PathPoint*>& currentPath =  
-        getCacheVariableValue<Array<PathPoint*> >(s, "current_path");
+        getCacheVariableValue(s, _currentPathCV);
     for (int i=0; i<currentPath.getSize(); i++) {
         PathPoint* mp = currentPath.get(i);
         PathWrapPoint* mwp = dynamic_cast<PathWrapPoint*>(mp);
@@ -1307,5 +1661,5 @@ void GeometryPath::updateDisplayPath(const SimTK::State& s) const
         currentDisplayPath.append(mp);
     }
 
-    markCacheVariableValid(s, "current_display_path");
+    markCacheVariableValid(s, _currentDisplayPathCV);
 }
@@ -31,6 +31,13 @@
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
+#include "PathSurrogate.h"
+#ifndef SWIG
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#endif
 
 
 #ifdef SWIG
@@ -68,6 +75,12 @@ private:
     
     OpenSim_DECLARE_OPTIONAL_PROPERTY(default_color, SimTK::Vec3, "Used to initialize the colour cache variable");
 
+    OpenSim_DECLARE_PROPERTY(surrogate_polynomial_order, int,
+        "Total degree of the polynomial in the spanned coordinates that "
+        "replaces the path when computing length, lengthening speed and "
+        "moment arms. 0 (default) computes them from the path points and "
+        "wrap objects.");
+
     // used for scaling tendon and fiber lengths
     double _preScaleLength;
 
@@ -78,6 +91,57 @@ private:
     // but we cannot simply use a unique_ptr because we want the pointer to be
     // cleared on copy.
     SimTK::NullOnCopyUniquePtr<MomentArmSolver> _maSolver;
+
+#ifndef SWIG
+    // Polynomial surrogate of the path, fitted the first time it is needed.
+    // It is published atomically, so it is read without locking; the mutex
+    // only serializes fitting. While a thread fits it, that thread samples
+    // the exact path. The surrogate refers to the model's coordinates, so it
+    // is cleared on copy too.
+    struct SurrogateFit {
+        std::shared_ptr<const PathSurrogate> surrogate;
+        std::recursive_mutex mutex;
+        std::atomic<std::thread::id> fittingThread;
+        SurrogateFit() : fittingThread(std::thread::id()) {}
+        SurrogateFit(const SurrogateFit&) : fittingThread(std::thread::id()) {}
+        SurrogateFit& operator=(const SurrogateFit&) { reset(); return *this; }
+        std::shared_ptr<const PathSurrogate> get() const
+        {   return std::atomic_load(&surrogate); }
+        void reset(const PathSurrogate* fitted = NULL)
+        {   std::atomic_store(&surrogate,
+                              std::shared_ptr<const PathSurrogate>(fitted)); }
+    };
+    mutable SurrogateFit _surrogate;
+
+    // How the path was last wrapped in a state. A cache entry keeps its value
+    // when the state changes, so each wrap computation can start from the
+    // order, outcomes and tangent points of the previous one in the same
+    // state (e.g., the previous time step) instead of from whichever state
+    // was computed last.
+    struct WrapCache {
+        bool valid;             // false until the path has been wrapped
+        Array<int> order;       // order the wrap objects were applied in
+        Array<int> result;      // WrapAction of each wrap object
+        std::vector<WrapResult> previousWrap;    // seed for each object
+        // ends of the path segment each object wrapped (NULL if none)
+        std::vector<const PathPoint*> segmentStart, segmentEnd;
+        WrapCache() : valid(false) {}
+        friend std::ostream& operator<<(std::ostream& o,
+            const WrapCache& wc) {
+            o << "GeometryPath::WrapCache should not be serialized!"
+              << std::endl;
+            return o;
+        }
+    };
+
+    // Handles of the cache variables allocated in extendAddToSystem().
+    mutable CacheVariable<double> _lengthCV;
+    mutable CacheVariable<double> _speedCV;
+    mutable CacheVariable<Array<PathPoint*> > _currentPathCV;
+    mutable CacheVariable<Array<PathPoint*> > _currentDisplayPathCV;
+    mutable CacheVariable<SimTK::Vec3> _colorCV;
+    mutable CacheVariable<WrapCache> _wrapCacheCV;
+#endif
     
 //=============================================================================
 // METHODS
@@ -174,6 +238,38 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    //--------------------------------------------------------------------------
+    // SURROGATE
+    //--------------------------------------------------------------------------
+    /** Fit the polynomial surrogate of order surrogate_polynomial_order to
+    the exact length of the path about the configuration in the given state.
+    The coordinates the path spans are found by sampling each coordinate of
+    the model over its range (rotations limited to [-pi, pi]); the length is
+    then sampled at random over those ranges and fitted by least squares, and
+    the fit is checked on further samples. If the path spans more than
+    PathSurrogate::MaxCoordinates coordinates, or a spanned coordinate's 
+    speed is not its time derivative, no surrogate is used and the path stays
+    exact. This is called automatically the first time the length, speed or
+    forces of the path are needed; call it again after changing the model's
+    coordinates or ranges. */
+    void fitSurrogate(const SimTK::State& s) const;
+    /** Set the total degree of the polynomial surrogate (at most
+        PathSurrogate::MaxOrder). 0 uses the exact path. Any fitted
+        surrogate is discarded. */
+    void setSurrogatePolynomialOrder(int order)
+    {   set_surrogate_polynomial_order(order); _surrogate.reset(); }
+    int getSurrogatePolynomialOrder() const
+    {   return get_surrogate_polynomial_order(); }
+    /** true if length, lengthening speed and forces (and therefore moment
+        arms) are computed from a fitted surrogate */
+    bool hasSurrogate() const;
+    /** Get the fitted surrogate, including its accuracy. Throws if there is
+        none. */
+    const PathSurrogate& getSurrogate() const;
+    /** Compute the length of the path from its points and wrap objects, even
+        when the path has a surrogate. Useful for validation. */
+    double computeExactLength(const SimTK::State& s) const;
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -205,6 +301,8 @@ protected:
 private:
 
     void computePath(const SimTK::State& s ) const;
+    std::shared_ptr<const PathSurrogate>
+        useSurrogate(const SimTK::State& s) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
     void applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path ) const;
     double calcPathLengthChange(const SimTK::State& s, const WrapObject& wo, 
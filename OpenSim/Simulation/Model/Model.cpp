@@ -1034,12 +1034,15 @@ void Model::equilibrateMuscles(SimTK::State& state)
     bool failed = false;
     string errorMsg = "";
 
-    for (int i = 0; i < get_ForceSet().getSize(); i++)
+    // The ForceSet keeps its list of muscles up to date when the model is
+    // connected, so there is no need to search the forces for them here.
+    const Set<Muscle>& muscles = getMuscles();
+    for (int i = 0; i < muscles.getSize(); i++)
     {
-        Muscle* muscle = dynamic_cast<Muscle*>(&get_ForceSet().get(i));
-        if (muscle != NULL && !muscle->isDisabled(state)){
+        const Muscle& muscle = muscles[i];
+        if (!muscle.isDisabled(state)){
             try{
-                muscle->equilibrate(state);
+                muscle.equilibrate(state);
             }
             catch (const std::exception& e) {
                 if(!failed){ // haven't failed to equlibrate other muscles yet
@@ -1891,46 +1894,12 @@ void Model::formStateStorage(const Storage& originalStorage, Storage& statesStor
         cout << "Number of columns does not match in formStateStorage. Found "
             << originalStorage.getSmallestNumberOfStates() << " Expected  " << rStateNames.getSize() << "." << endl;
     }
-    // Create a list with entry for each desiredName telling which column in originalStorage has the data
-    int* mapColumns = new int[rStateNames.getSize()];
+    // Create a list with entry for each desiredName telling which state in originalStorage has the data
+    // (-1 if none), allowing for the state labels of earlier versions
+    Array<int> mapColumns;
+    originalStorage.getStateIndices(rStateNames, mapColumns);
     for(int i=0; i< rStateNames.getSize(); i++){
-        // the index is -1 if not found, >=1 otherwise since time has index 0 by defn.
-        int fix = originalStorage.getColumnLabels().findIndex(rStateNames[i]);
-        if (fix==-1){
-            // try removing the complete path name to identify the state_name in storage
-            string::size_type last = rStateNames[i].rfind("/");
-            string name = rStateNames[i].substr(last+1, rStateNames[i].length()-last);
-            fix = originalStorage.getColumnLabels().findIndex(name);
-            // this whole method is one big hack and needs to be eliminated- aseth
-            // for the time being, allow the new coordinate labeling to be
-            // handled from storages generated by older versions
-            if (fix == -1){
-                if (name == "value"){
-                    // old formats did not have "/value" so remove it if here
-                    name = rStateNames[i].substr(0, last);
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, name.length());
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-                else if (name == "speed"){
-                    // replace "/speed" (the latest labeling for speeds) with "_u"
-                    name = rStateNames[i].substr(0, last);
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, name.length() - last) + "_u";
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-                else {
-                    // try replacing the '/' with '.' in the last connection
-                    name = rStateNames[i];
-                    name.replace(last, 1, ".");
-                    last = name.rfind("/");
-                    name = name.substr(last + 1, rStateNames[i].length() - last);
-                    fix = originalStorage.getColumnLabels().findIndex(name);
-                }
-            }
-        }
-        mapColumns[i] = fix;
-        if (fix==-1){
+        if (mapColumns[i]<0){
             cout << "Column "<< rStateNames[i] << " not found in formStateStorage, assuming 0." << endl;
         }
     }
@@ -1942,8 +1911,8 @@ void Model::formStateStorage(const Storage& originalStorage, Storage& statesStor
         stateVec->getData().setSize(numStates);  // default value 0f 0.
         for(int column=0; column< numStates; column++){
             double valueInOriginalStorage=0.0;
-            if (mapColumns[column]!=-1)
-                originalVec->getDataValue(mapColumns[column]-1, valueInOriginalStorage);
+            if (mapColumns[column]>=0)
+                originalVec->getDataValue(mapColumns[column], valueInOriginalStorage);
 
             stateVec->setDataValue(column, valueInOriginalStorage);
 
@@ -1952,8 +1921,6 @@ void Model::formStateStorage(const Storage& originalStorage, Storage& statesStor
     }
     rStateNames.insert(0, "time");
     statesStorage.setColumnLabels(rStateNames);
-
-    delete mapColumns;
 }
 
 /**
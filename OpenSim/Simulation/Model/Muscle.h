@@ -775,6 +775,14 @@ protected:
     };
 
 
+#ifndef SWIG
+    /** Handles of the cache variables holding the structs above. */
+    mutable CacheVariable<MuscleLengthInfo> _lengthInfoCV;
+    mutable CacheVariable<FiberVelocityInfo> _velInfoCV;
+    mutable CacheVariable<MuscleDynamicsInfo> _dynamicsInfoCV;
+    mutable CacheVariable<MusclePotentialEnergyInfo> _potentialEnergyInfoCV;
+#endif
+
     /** to support deprecated muscles */
     double _maxIsometricForce;
     double _optimalFiberLength;
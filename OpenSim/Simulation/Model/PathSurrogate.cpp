@@ -0,0 +1,207 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  PathSurrogate.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2012 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "PathSurrogate.h"
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+
+//=============================================================================
+// STATICS
+//=============================================================================
+using namespace std;
+using namespace OpenSim;
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+//_____________________________________________________________________________
+/*
+ * Default constructor.
+ */
+PathSurrogate::PathSurrogate() :
+    _order(0),
+    _numTerms(0),
+    _maxLengthError(SimTK::NaN),
+    _maxMomentArmError(SimTK::NaN)
+{
+}
+
+//_____________________________________________________________________________
+/*
+ * Construct an unfitted surrogate and enumerate its terms: every combination
+ * of per-coordinate degrees whose sum does not exceed the order.
+ */
+PathSurrogate::PathSurrogate(const Array<const Coordinate*>& coordinates,
+                             const vector<double>& lower,
+                             const vector<double>& upper, int order) :
+    _coordinates(coordinates),
+    _order(order),
+    _numTerms(0),
+    _maxLengthError(SimTK::NaN),
+    _maxMomentArmError(SimTK::NaN)
+{
+    const int nc = _coordinates.getSize();
+    if (nc > MaxCoordinates || order < 0 || order > MaxOrder)
+        throw Exception("PathSurrogate: too many coordinates or order out "
+                        "of range.",__FILE__,__LINE__);
+
+    for (int i = 0; i < nc; ++i) {
+        _center.push_back(0.5*(upper[i] + lower[i]));
+        _halfWidth.push_back(0.5*(upper[i] - lower[i]));
+    }
+
+    vector<int> degree(nc, 0);
+    int total = 0;
+    while (true) {
+        _exponents.insert(_exponents.end(), degree.begin(), degree.end());
+        ++_numTerms;
+
+        // Advance to the next combination like an odometer, skipping those
+        // whose total degree is too high.
+        int i = 0;
+        for (; i < nc; ++i) {
+            ++degree[i];
+            ++total;
+            if (total <= order)
+                break;
+            total -= degree[i];
+            degree[i] = 0;
+        }
+        if (i == nc)
+            break;
+    }
+}
+
+//=============================================================================
+// COMPUTATIONS
+//=============================================================================
+//_____________________________________________________________________________
+/*
+ * Chebyshev polynomials of each coordinate, mapped onto [-1, 1], and their
+ * derivatives with respect to the mapped coordinate.
+ */
+void PathSurrogate::calcChebyshev(const double* q,
+                                  double T[MaxCoordinates][MaxOrder+1],
+                                  double dT[MaxCoordinates][MaxOrder+1]) const
+{
+    for (int i = 0; i < getNumCoordinates(); ++i) {
+        const double x = (q[i] - _center[i])/_halfWidth[i];
+        T[i][0] = 1.0;
+        dT[i][0] = 0.0;
+        if (_order > 0) {
+            T[i][1] = x;
+            dT[i][1] = 1.0;
+        }
+        for (int k = 1; k < _order; ++k) {
+            T[i][k+1] = 2*x*T[i][k] - T[i][k-1];
+            dT[i][k+1] = 2*T[i][k] + 2*x*dT[i][k] - dT[i][k-1];
+        }
+    }
+}
+
+//_____________________________________________________________________________
+/*
+ * Least-squares fit of the coefficients.
+ */
+void PathSurrogate::fit(const SimTK::Matrix& q, const SimTK::Vector& lengths)
+{
+    const int nc = getNumCoordinates();
+    const int ns = q.nrow();
+    if (ns < _numTerms || lengths.size() != ns)
+        throw Exception("PathSurrogate::fit: need at least one sample per "
+                        "term.",__FILE__,__LINE__);
+
+    double qi[MaxCoordinates];
+    double T[MaxCoordinates][MaxOrder+1], dT[MaxCoordinates][MaxOrder+1];
+
+    SimTK::Matrix basis(ns, _numTerms);
+    for (int r = 0; r < ns; ++r) {
+        for (int i = 0; i < nc; ++i)
+            qi[i] = q(r, i);
+        calcChebyshev(qi, T, dT);
+        for (int t = 0; t < _numTerms; ++t) {
+            const int* degree = nc > 0 ? &_exponents[t*nc] : NULL;
+            double value = 1.0;
+            for (int i = 0; i < nc; ++i)
+                value *= T[i][degree[i]];
+            basis(r, t) = value;
+        }
+    }
+
+    SimTK::FactorQTZ qtz(basis);
+    SimTK::Vector coefficients;
+    qtz.solve(lengths, coefficients);
+    _coefficients = coefficients;
+}
+
+//_____________________________________________________________________________
+/*
+ * Evaluate the length and, optionally, its gradient. The gradient of each
+ * term is formed from running products of the other coordinates' factors.
+ */
+double PathSurrogate::calcLength(const double* q, double* dLdq) const
+{
+    const int nc = getNumCoordinates();
+    double T[MaxCoordinates][MaxOrder+1], dT[MaxCoordinates][MaxOrder+1];
+    double leading[MaxCoordinates+1];
+    calcChebyshev(q, T, dT);
+
+    if (dLdq)
+        for (int i = 0; i < nc; ++i)
+            dLdq[i] = 0.0;
+
+    double length = 0.0;
+    for (int t = 0; t < _numTerms; ++t) {
+        const int* degree = nc > 0 ? &_exponents[t*nc] : NULL;
+        const double c = _coefficients[t];
+
+        leading[0] = 1.0;
+        for (int i = 0; i < nc; ++i)
+            leading[i+1] = leading[i]*T[i][degree[i]];
+        length += c*leading[nc];
+
+        if (dLdq) {
+            double trailing = c;
+            for (int i = nc-1; i >= 0; --i) {
+                dLdq[i] += leading[i]*dT[i][degree[i]]*trailing;
+                trailing *= T[i][degree[i]];
+            }
+        }
+    }
+
+    if (dLdq)
+        for (int i = 0; i < nc; ++i)
+            dLdq[i] /= _halfWidth[i];
+
+    return length;
+}
+
+double PathSurrogate::calcLength(const SimTK::State& s, double* dLdq) const
+{
+    double q[MaxCoordinates];
+    for (int i = 0; i < getNumCoordinates(); ++i)
+        q[i] = _coordinates[i]->getValue(s);
+    return calcLength(q, dLdq);
+}
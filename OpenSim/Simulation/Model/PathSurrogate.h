@@ -0,0 +1,141 @@
+#ifndef OPENSIM_PATH_SURROGATE_H_
+#define OPENSIM_PATH_SURROGATE_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  PathSurrogate.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2012 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// INCLUDES
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Common/Array.h>
+#include "SimTKcommon.h"
+#include <vector>
+
+namespace OpenSim {
+
+class Coordinate;
+
+//=============================================================================
+//=============================================================================
+/** Polynomial approximation of the length of a GeometryPath as a function of
+    the coordinates the path spans. The length is a sum of products of
+    Chebyshev polynomials, one per coordinate, whose total degree is at most
+    the order of the surrogate. Each coordinate is mapped from its sampled
+    interval onto [-1, 1]. Because the polynomial is differentiable, the
+    derivatives of the length with respect to the coordinates (the negative of
+    the moment arms when qdot = u) come with every evaluation.
+ *
+ * A GeometryPath fits its surrogate from samples of its exact length and
+ * records the largest errors it found on a separate set of samples.
+ *
+ * @version 1.0
+ */
+class OSIMSIMULATION_API PathSurrogate
+{
+
+//=============================================================================
+// MEMBER VARIABLES
+//=============================================================================
+public:
+    /** Largest number of coordinates and largest order a surrogate can have. */
+    static const int MaxCoordinates = 6;
+    static const int MaxOrder = 8;
+
+private:
+    /** Coordinates that are the arguments of the polynomial */
+    Array<const Coordinate*> _coordinates;
+    /** Centers and half widths of the intervals mapped onto [-1, 1] */
+    std::vector<double> _center;
+    std::vector<double> _halfWidth;
+    /** Total degree of the polynomial */
+    int _order;
+    /** Number of terms and the degree of each coordinate in each term,
+        term by term */
+    int _numTerms;
+    std::vector<int> _exponents;
+    /** Coefficient of each term; empty until the surrogate is fitted */
+    SimTK::Vector _coefficients;
+    /** Largest errors found when the surrogate was validated */
+    double _maxLengthError;
+    double _maxMomentArmError;
+
+//=============================================================================
+// METHODS
+//=============================================================================
+    //--------------------------------------------------------------------------
+    // CONSTRUCTION
+    //--------------------------------------------------------------------------
+public:
+    /** An empty surrogate, which is not valid. */
+    PathSurrogate();
+    /** A surrogate of the given order in the given coordinates, which are
+        sampled between lower and upper. It is valid once it is fitted. */
+    PathSurrogate(const Array<const Coordinate*>& coordinates,
+                  const std::vector<double>& lower,
+                  const std::vector<double>& upper, int order);
+    virtual ~PathSurrogate() {};
+
+    //--------------------------------------------------------------------------
+    // GET AND SET
+    //--------------------------------------------------------------------------
+    /** true once the coefficients have been fitted */
+    bool isValid() const { return _coefficients.size() > 0; }
+    int getNumCoordinates() const { return _coordinates.getSize(); }
+    const Coordinate& getCoordinate(int i) const { return *_coordinates[i]; }
+    int getOrder() const { return _order; }
+    int getNumTerms() const { return _numTerms; }
+    /** Get the lower and upper end of the interval sampled for coordinate i */
+    double getLowerBound(int i) const { return _center[i] - _halfWidth[i]; }
+    double getUpperBound(int i) const { return _center[i] + _halfWidth[i]; }
+
+    /** Largest absolute error in length (m) and in moment arm (m) found when
+        the surrogate was validated against the exact path */
+    double getMaxLengthError() const { return _maxLengthError; }
+    double getMaxMomentArmError() const { return _maxMomentArmError; }
+    void setAccuracy(double maxLengthError, double maxMomentArmError)
+    {   _maxLengthError = maxLengthError;
+        _maxMomentArmError = maxMomentArmError; }
+
+    //--------------------------------------------------------------------------
+    // COMPUTATIONS
+    //--------------------------------------------------------------------------
+    /** Fit the coefficients to sampled lengths by least squares.
+    @param q        sampled coordinate values, one row per sample
+    @param lengths  exact length of the path at each sample */
+    void fit(const SimTK::Matrix& q, const SimTK::Vector& lengths);
+
+    /** Evaluate the length at the given coordinate values. If dLdq is not
+        NULL it receives the derivative of the length with respect to each
+        coordinate. */
+    double calcLength(const double* q, double* dLdq=NULL) const;
+    /** Evaluate the length at the coordinate values in the state. */
+    double calcLength(const SimTK::State& s, double* dLdq=NULL) const;
+
+private:
+    void calcChebyshev(const double* q,
+                       double T[MaxCoordinates][MaxOrder+1],
+                       double dT[MaxCoordinates][MaxOrder+1]) const;
+
+//=============================================================================
+};  // END of class PathSurrogate
+//=============================================================================
+} // namespace
+
+#endif // OPENSIM_PATH_SURROGATE_H_
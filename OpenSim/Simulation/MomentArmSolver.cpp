@@ -27,6 +27,11 @@
 #include "Model/Model.h"
 #include "SimbodyEngine/Body.h"
 
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
 using namespace std;
 using namespace SimTK;
 
@@ -40,6 +45,7 @@ namespace OpenSim {
 MomentArmSolver::MomentArmSolver(const Model &model) : Solver(model)
 {
     setAuthors("Ajay Seth");
+    _numThreads = 1;
     _stateCopy = model.getWorkingState();
 
     // Get the body forces equivalent of the point forces of the path
@@ -73,22 +79,8 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     // set speeds to zero
     s_ma.updU() = 0;
 
-    // zero out all the forces
-    _bodyForces *= 0;
-    _generalizedForces = 0;
-
-    // apply a tension of unity to the bodies of the path
-    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
-    path.addInEquivalentForces(s_ma, 1.0, _bodyForces, pathDependentMobilityForces);
-
-    //_bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
-
-    // Convert body spatial forces F to equivalent mobility forces f based on 
-    // geometry (no dynamics required): f = ~J(q) * F.
-    getModel().getMultibodySystem().getMatterSubsystem()
-        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
+    computePathGeneralizedForces(s_ma, path, _bodyForces, _generalizedForces);
 
-    _generalizedForces += pathDependentMobilityForces;
     // Moment-arm is the effective torque (since tension is 1) at the 
     // coordinate of interest taking into account the generalized forces also 
     // acting on other coordinates that are coupled via constraint.
@@ -134,6 +126,88 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+void MomentArmSolver::solve(const State &state,
+                            const Array<const Coordinate*> &coordinates,
+                            const Array<const GeometryPath*> &paths,
+                            Matrix &momentArms) const
+{
+    int nc = coordinates.getSize();
+    int np = paths.getSize();
+    momentArms.resize(nc, np);
+    if(nc==0 || np==0) return;
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints, once for
+    // each coordinate rather than once for each path and coordinate
+    Matrix coupling(s_ma.getNU(), nc);
+    for(int i=0; i<nc; i++)
+        coupling(i) = computeCouplingVector(s_ma, *coordinates[i]);
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    // The generalized forces of a path do not depend on the coordinate, so
+    // they are computed once for each path. The paths are independent, so
+    // they are divided among threads, each with its own copy of the state.
+    Matrix pathForces(s_ma.getNU(), np);
+    int nThreads = _numThreads>0 ? _numThreads :
+        (int)std::thread::hardware_concurrency();
+    if(nThreads > np) nThreads = np;
+    if(nThreads < 1) nThreads = 1;
+    std::vector<State> states(nThreads-1, s_ma);
+    std::atomic<int> next(0);
+    std::vector<std::exception_ptr> errors(nThreads);
+    auto solvePaths = [&](State& ks, int k) {
+        try {
+            Vector_<SpatialVec> bodyForces(_bodyForces.size());
+            Vector generalizedForces(ks.getNU());
+            for(int j=next++; j<np; j=next++) {
+                computePathGeneralizedForces(ks, *paths[j], bodyForces,
+                                             generalizedForces);
+                pathForces(j) = generalizedForces;
+            }
+        } catch(...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int k=0; k<nThreads-1; k++)
+        threads.push_back(std::thread(solvePaths, std::ref(states[k]), k));
+    solvePaths(s_ma, nThreads-1);
+    for(size_t k=0; k<threads.size(); k++) threads[k].join();
+    for(int k=0; k<nThreads; k++)
+        if(errors[k]) std::rethrow_exception(errors[k]);
+
+    // Moment-arm of each path about each coordinate is its effective torque
+    // (since tension is 1) taking into account coupling via constraints.
+    momentArms = ~coupling*pathForces;
+}
+
+void MomentArmSolver::computePathGeneralizedForces(const State &s_ma,
+        const GeometryPath &path, Vector_<SpatialVec> &bodyForces,
+        Vector &generalizedForces) const
+{
+    // zero out all the forces
+    bodyForces = SpatialVec(Vec3(0), Vec3(0));
+    generalizedForces = 0;
+
+    // apply a tension of unity to the bodies of the path
+    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
+    path.addInEquivalentForces(s_ma, 1.0, bodyForces, pathDependentMobilityForces);
+
+    //bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
+
+    // Convert body spatial forces F to equivalent mobility forces f based on 
+    // geometry (no dynamics required): f = ~J(q) * F.
+    getModel().getMultibodySystem().getMatterSubsystem()
+        .multiplyBySystemJacobianTranspose(s_ma, bodyForces, generalizedForces);
+
+    generalizedForces += pathDependentMobilityForces;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
@@ -50,6 +50,9 @@ OpenSim_DECLARE_CONCRETE_OBJECT(MomentArmSolver, Solver);
 // MEMBER VARIABLES
 //=============================================================================
 private:
+    /** Number of threads used to solve for several paths (0 for all
+        processors). */
+    int _numThreads;
 
 //=============================================================================
 // METHODS
@@ -82,6 +85,29 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of several GeometryPaths about
+        several coordinates. The coupling vector of each coordinate and the
+        generalized forces due to a unit tension in each path are computed
+        only once, and the moment-arms are their products.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @param  momentArms          resulting moment-arms, with one row for each
+                                coordinate and one column for each path
+    */
+    void solve(const SimTK::State& state, 
+        const Array<const Coordinate*>& coordinates,
+        const Array<const GeometryPath*>& paths,
+        SimTK::Matrix& momentArms) const;
+
+    /** Set the number of threads used to compute the generalized forces of
+        several paths. A value of 0 uses as many threads as there are
+        processors. The default is 1. */
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
+    /** Get the number of threads used to compute the generalized forces of
+        several paths. */
+    int getNumThreads() const { return _numThreads; }
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -98,6 +124,12 @@ private:
     // compute vector of constraint coupling factors
     SimTK::Vector computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const;
+
+    // compute the generalized forces due to a unit tension in a path
+    void computePathGeneralizedForces(const SimTK::State &state,
+        const GeometryPath &path,
+        SimTK::Vector_<SimTK::SpatialVec> &bodyForces,
+        SimTK::Vector &generalizedForces) const;
 //=============================================================================
 };  // END of class MomentArmSolver
 //=============================================================================
@@ -50,6 +50,9 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      SimTK::Vec2 rom = SimTK::Vec2(-SimTK::Pi/2,0),
                                      double mass = -1.0, string errorMessage = "");
 
+void testBatchedMomentArms(const string &filename);
+void testPathSurrogate(const string &filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -118,6 +121,12 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testBatchedMomentArms("gait2354_simbody.osim");
+        cout << "Moment arms of all muscles about all coordinates: PASSED\n" << endl;
+
+        testPathSurrogate("gait2354_simbody.osim");
+        cout << "Polynomial surrogate of a path with a moving point: PASSED\n" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -405,3 +414,88 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+//==========================================================================================================
+// Moment arms solved for all muscles and coordinates at once must match those
+// solved one muscle and one coordinate at a time.
+//==========================================================================================================
+void testBatchedMomentArms(const string &filename)
+{
+    Model osimModel(filename);
+    SimTK::State &s = osimModel.initSystem();
+
+    CoordinateSet &coords = osimModel.updCoordinateSet();
+    const Set<Muscle> &muscles = osimModel.getMuscles();
+    Array<const Coordinate*> coordinates;
+    for(int i=0; i<coords.getSize(); i++)
+        coordinates.append(&coords[i]);
+    Array<const GeometryPath*> paths;
+    for(int j=0; j<muscles.getSize(); j++)
+        paths.append(&muscles[j].getGeometryPath());
+
+    coords.get("knee_angle_r").setValue(s, -SimTK::Pi/4, false);
+    coords.get("hip_flexion_r").setValue(s, SimTK::Pi/6, true);
+
+    MomentArmSolver maSolver(osimModel);
+    for(int nThreads=1; nThreads<=4; nThreads+=3) {
+        maSolver.setNumThreads(nThreads);
+        SimTK::Matrix momentArms;
+        maSolver.solve(s, coordinates, paths, momentArms);
+        ASSERT(momentArms.nrow()==coords.getSize());
+        ASSERT(momentArms.ncol()==muscles.getSize());
+        for(int i=0; i<coords.getSize(); i++) {
+            for(int j=0; j<muscles.getSize(); j++) {
+                double ma = muscles[j].computeMomentArm(s, coords[i]);
+                ASSERT_EQUAL(ma, momentArms(i,j), 1e-10);
+            }
+        }
+    }
+}
+
+void testPathSurrogate(const string &filename)
+{
+    Model osimModel(filename);
+    GeometryPath &path = osimModel.updMuscles().get("vas_int_r").updGeometryPath();
+    path.setSurrogatePolynomialOrder(6);
+    SimTK::State &s = osimModel.initSystem();
+
+    Model exactModel(filename);
+    SimTK::State &se = exactModel.initSystem();
+    const GeometryPath &exactPath = exactModel.getMuscles().get("vas_int_r").getGeometryPath();
+
+    // The surrogate is fitted on first use, to the knee only.
+    const Coordinate &knee = osimModel.getCoordinateSet().get("knee_angle_r");
+    const Coordinate &exactKnee = exactModel.getCoordinateSet().get("knee_angle_r");
+    path.getLength(s);
+    ASSERT(path.hasSurrogate());
+    const PathSurrogate &surrogate = path.getSurrogate();
+    ASSERT(surrogate.getNumCoordinates()==1);
+    ASSERT(&surrogate.getCoordinate(0)==&knee);
+    cout << "Surrogate errors: length " << surrogate.getMaxLengthError()
+         << " m, moment arm " << surrogate.getMaxMomentArmError() << " m" << endl;
+    ASSERT(surrogate.getMaxLengthError() < 1e-3);
+    ASSERT(surrogate.getMaxMomentArmError() < 5e-3);
+
+    double lengthTol = 2*surrogate.getMaxLengthError() + 1e-6;
+    double maTol = 2*surrogate.getMaxMomentArmError() + 1e-6;
+    for(int k=0; k<=10; k++) {
+        double angle = -2*SimTK::Pi/3 + k*(2*SimTK::Pi/3 + SimTK::Pi/18)/10;
+        knee.setValue(s, angle);
+        knee.setSpeedValue(s, 1.0);
+        osimModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        exactKnee.setValue(se, angle);
+
+        double dLdq;
+        double length = surrogate.calcLength(s, &dLdq);
+        ASSERT_EQUAL(length, path.getLength(s), 1e-12);
+        ASSERT_EQUAL(dLdq, path.getLengtheningSpeed(s), 1e-12);
+        // Forces, and hence moment arms, follow the surrogate's gradient.
+        ASSERT_EQUAL(-dLdq, path.computeMomentArm(s, knee), 1e-8);
+
+        // and stay within the reported accuracy of the exact path, which is
+        // still available.
+        ASSERT_EQUAL(exactPath.getLength(se), path.computeExactLength(s), 1e-12);
+        ASSERT_EQUAL(exactPath.getLength(se), length, lengthTol);
+        ASSERT_EQUAL(exactPath.computeMomentArm(se, exactKnee), -dLdq, maTol);
+    }
+}
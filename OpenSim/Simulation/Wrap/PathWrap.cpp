@@ -226,11 +226,13 @@ void PathWrap::resetPreviousWrap()
 
     _previousWrap.wrap_pts.setSize(0);
     _previousWrap.wrap_path_length = 0.0;
+    _previousWrap.factor = 1.0;
 
     int i;
     for (i = 0; i < 3; i++) {
         _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
         _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        _previousWrap.c1[i] = 0.0;
         _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
     }
 }
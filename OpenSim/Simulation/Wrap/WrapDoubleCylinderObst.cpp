@@ -536,7 +536,12 @@ int WrapDoubleCylinderObst::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1
     quick_sub_vec_fm_vec( ss, V, vs );                  // Translate s from Vcyl body to Vcyl obstacle
     quick_mul_vec_by_mtxT( vs, VcylObstToVcylBody, vs );    // Rotate s into Vcyl obstacle frame
 
+    // The active state of the previous wrap is kept in c1. Both cylinders
+    // being active needs the previous T as well, so restart from the U
+    // cylinder alone, which activates the V cylinder again if needed.
+    aWrapResult.c1 = aPathWrap.getPreviousWrap().c1;
     int activeState=(int)aWrapResult.c1[0]; // _activeState;    // TEMP set to zero
+    if( activeState==3 ) activeState=1;
     if( (int)aWrapResult.c1[1] != 12345 ) { aWrapResult.c1[1]=12345.01; activeState=0; }    // Initialize activeState first iteration
     double_cylinder(u,Ru,v,Rv,  VcylObstToUcylObst,  P,q,Q,T,t,vs, &Pq,&qQ,&QT,&Tt,&tS,&L, &activeState, &ru,&rv);
 //  _activeState=activeState;       ???? I CAN'T SEEM TO SET THIS!!!  GARNER - Needs to be Set in a WrapResult variable.
@@ -51,6 +51,7 @@ void simulateModelWithPassiveMuscles(const string &modelFile, double finalTime);
 void simulateModelWithoutMuscles(const string &modelFile, double finalTime);
 void simulateModelWithLigaments(const string &modelFile, double finalTime);
 void simulateModelWithCables(const string &modelFile, double finalTime);
+void testWarmStartedWrapping(const string &modelFile);
 
 int main()
 {
@@ -62,6 +63,12 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("TestShoulderModel (multiple wrap)"); }
 
+    try{// wrapping seeded from the previous step matches other seeds
+        testWarmStartedWrapping("TestShoulderModel.osim");}
+    catch (const std::exception& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        failures.push_back("TestShoulderModel (warm-started wrap)"); }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -794,3 +801,30 @@ void simulate(Model& osimModel, State& si, double initialTime, double finalTime)
     states.print(osimModel.getName()+"_states_degrees.mot");
 } // end of simulate()
 
+// Step all coordinates in small increments, wrapping muscle paths in one state
+// that is seeded from each previous step, and compare with states that are
+// seeded from the initial pose.
+void testWarmStartedWrapping(const string &modelFile)
+{
+    Model model(modelFile);
+    State& s = model.initSystem();
+    const CoordinateSet& coords = model.getCoordinateSet();
+    const Set<Muscle>& muscles = model.getMuscles();
+
+    State warm = s;
+    for (int k = 1; k <= 20; ++k) {
+        State reference = s;
+        for (int i = 0; i < coords.getSize(); ++i) {
+            if (coords[i].getLocked(s))
+                continue;
+            double q = coords[i].getValue(s) + 0.01*k;
+            coords[i].setValue(warm, q, false);
+            coords[i].setValue(reference, q, false);
+        }
+        model.getMultibodySystem().realize(warm, Stage::Position);
+        model.getMultibodySystem().realize(reference, Stage::Position);
+        for (int j = 0; j < muscles.getSize(); ++j)
+            ASSERT_EQUAL(muscles[j].getLength(reference),
+                         muscles[j].getLength(warm), 1e-4);
+    }
+}
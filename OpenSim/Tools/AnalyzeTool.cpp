@@ -34,6 +34,9 @@
 #include <OpenSim/Analyses/ProbeReporter.h>
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <thread>
+#include <memory>
+#include <exception>
 
 using namespace OpenSim;
 using namespace std;
@@ -59,6 +62,7 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false),
     _printResultFiles(true)
 {
@@ -79,6 +83,7 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(aLoadModelAndInput),
     _printResultFiles(true)
 {
@@ -111,6 +116,7 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false),
     _printResultFiles(true)
 {
@@ -171,6 +177,7 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +198,7 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
 
     _statesStore = NULL;
 
@@ -236,6 +244,14 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to analyze the frames of the states. With more than one thread, "
+                 "the frames are split into consecutive blocks that are analyzed concurrently by copies of the model, "
+                 "and the results of the analyses are merged in time order. A value of 0 uses one thread per processor. "
+                 "The default value is 1, so the frames are analyzed one after the other.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
 }
 
 
@@ -259,6 +275,7 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -568,7 +585,8 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     cout<<"Executing the analyses from "<<ti<<" to "<<tf<<"..."<<endl;
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates,
+        plotting ? 1 : _numThreads);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -602,6 +620,146 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     GCVSplineSet statesSplineSet(5,&aStatesStore);
 
     // PERFORM THE ANALYSES
+    runFrames(s, aModel, iInitial, iFinal, aStatesStore, aSolveForEquilibrium, true, true);
+}
+//_____________________________________________________________________________
+/**
+ * Run the analyses of a model over frames of the states using several
+ * threads.
+ *
+ * The frames before the final frame are split into consecutive blocks.  The
+ * first block is analyzed by aModel on the calling thread while each other
+ * block is analyzed concurrently by a copy of aModel on its own thread.
+ * Since begin() records the first frame of a block, blocks after the first
+ * start at frames that every analysis records according to its step
+ * interval.  The rows recorded by the copies in the storages of their
+ * analyses (see Analysis::getStorageList()) are then appended, in time
+ * order, to the storages of the analyses of aModel, which finally analyzes
+ * the final frame.  Other results kept by an analysis between frames, and
+ * states that are not in aStatesStore, are not carried from one block to
+ * the next.  If an analysis that is on lists no storages, its results could
+ * not be merged, so all frames are then analyzed again one after the other
+ * by aModel.
+ *
+ * @param aNumThreads Number of threads.  If 0 or less, one thread per
+ * processor is used.  If the frames do not split into at least two blocks,
+ * they are analyzed one after the other as by the serial run().
+ */
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int aNumThreads)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+    if(aNumThreads<=0) aNumThreads = (int)std::thread::hardware_concurrency();
+
+    // BLOCKS
+    // Start blocks at multiples of the step intervals of the analyses.
+    int stepInterval = 1;
+    for(int i=0;i<analysisSet.getSize();i++) {
+        int interval = analysisSet.get(i).getStepInterval();
+        if(!analysisSet.get(i).getOn() || interval<=1) continue;
+        int a = stepInterval, b = interval;
+        while(b!=0) { int r = a%b; a = b; b = r; }
+        stepInterval = (stepInterval/a)*interval;
+    }
+    int nFrames = iFinal - iInitial;
+    vector<int> blockStarts(1, iInitial);
+    for(int k=1;k<aNumThreads && nFrames>1;k++) {
+        int start = iInitial + (int)((long long)k*nFrames/aNumThreads);
+        start = ((start + stepInterval - 1)/stepInterval)*stepInterval;
+        if(start>blockStarts.back() && start<iFinal) blockStarts.push_back(start);
+    }
+    int nBlocks = (int)blockStarts.size();
+    if(nBlocks<2) {
+        run(s, aModel, iInitial, iFinal, aStatesStore, aSolveForEquilibrium);
+        return;
+    }
+    blockStarts.push_back(iFinal);
+
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setStatesStore(aStatesStore);
+    }
+
+    // COPIES OF THE MODEL
+    // Copy before any frame is analyzed, since analyzing a frame can alter
+    // the properties of aModel.
+    vector<unique_ptr<Model> > models;
+    for(int k=1;k<nBlocks;k++)
+        models.push_back(unique_ptr<Model>(aModel.clone()));
+
+    // ANALYZE THE BLOCKS
+    cout << "Analyzing " << nFrames << " frames in " << nBlocks << " blocks..." << endl;
+    // States that are not in aStatesStore start from their values in s.
+    const SimTK::Vector y = s.getY();
+    vector<exception_ptr> errors(nBlocks);
+    vector<thread> threads;
+    for(int k=1;k<nBlocks;k++) {
+        threads.push_back(thread([&, k]() {
+            try {
+                Model& model = *models[k-1];
+                SimTK::State& ks = model.initSystem();
+                if(ks.getNY()==y.size()) ks.updY() = y;
+                AnalysisSet& kAnalysisSet = model.updAnalysisSet();
+                for(int i=0;i<kAnalysisSet.getSize();i++)
+                    kAnalysisSet.get(i).setStatesStore(aStatesStore);
+                runFrames(ks, model, blockStarts[k], blockStarts[k+1]-1,
+                    aStatesStore, aSolveForEquilibrium, true, false);
+            } catch(...) {
+                errors[k] = current_exception();
+            }
+        }));
+    }
+    try {
+        runFrames(s, aModel, iInitial, blockStarts[1]-1, aStatesStore,
+            aSolveForEquilibrium, true, false);
+    } catch(...) {
+        errors[0] = current_exception();
+    }
+    for(size_t k=0;k<threads.size();k++) threads[k].join();
+    for(int k=0;k<nBlocks;k++)
+        if(errors[k]) rethrow_exception(errors[k]);
+
+    // The storages of an analysis are listed by the time begin() returns.
+    for(int i=0;i<analysisSet.getSize();i++) {
+        Analysis& analysis = analysisSet.get(i);
+        if(analysis.getOn() && analysis.getStorageList().getSize()==0) {
+            cout << "AnalyzeTool.run: analysis " << analysis.getName() << " does not list its storages, "
+                 << "so its results from other threads cannot be merged. Analyzing the frames on one thread." << endl;
+            run(s, aModel, iInitial, iFinal, aStatesStore, aSolveForEquilibrium);
+            return;
+        }
+    }
+
+    // MERGE THE RESULTS
+    for(int k=1;k<nBlocks;k++) {
+        AnalysisSet& kAnalysisSet = models[k-1]->updAnalysisSet();
+        for(int i=0;i<analysisSet.getSize();i++) {
+            ArrayPtrs<Storage>& storages = analysisSet.get(i).getStorageList();
+            ArrayPtrs<Storage>& kStorages = kAnalysisSet.get(i).getStorageList();
+            if(kStorages.getSize()!=storages.getSize()) {
+                string msg = "AnalyzeTool.run: ERROR- the copy of analysis ";
+                msg += analysisSet.get(i).getName() + " has different storages.";
+                throw Exception(msg,__FILE__,__LINE__);
+            }
+            for(int j=0;j<storages.getSize();j++) {
+                const Storage& kStorage = *kStorages[j];
+                for(int r=0;r<kStorage.getSize();r++)
+                    storages[j]->append(*kStorage.getStateVector(r));
+            }
+        }
+    }
+
+    // FINAL FRAME
+    runFrames(s, aModel, iFinal, iFinal, aStatesStore, aSolveForEquilibrium, false, true);
+}
+//_____________________________________________________________________________
+/**
+ * Analyze the frames iFirst to iLast of the states.  The first frame is
+ * passed to begin() if aBegin is true, the last to end() if aEnd is true,
+ * and all others to step().
+ */
+void AnalyzeTool::runFrames(SimTK::State& s, Model &aModel, int iFirst, int iLast, const Storage &aStatesStore, bool aSolveForEquilibrium, bool aBegin, bool aEnd)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+
     double tPrev=0.0,t=0.0,dt=0.0;
     int ny = s.getNY();
     Array<double> dydt(0.0,ny);
@@ -613,7 +771,13 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     SimTK::Vector stateData;
     stateData.resize(numOpenSimStates);
 
-    for(int i=iInitial;i<=iFinal;i++) {
+    // Resolve the state variable of each column once, falling back to
+    // access by name if the model cannot resolve it by index
+    Array<int> stateIndices(-1, numOpenSimStates);
+    for (int j=0; j<numOpenSimStates; ++j)
+        stateIndices[j] = aModel.getStateVariableIndex(labels[j+1]);
+
+    for(int i=iFirst;i<=iLast;i++) {
         tPrev = t;
         aStatesStore.getTime(i,s.updTime()); // time
         t = s.getTime();
@@ -622,10 +786,11 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         aStatesStore.getData(i,numOpenSimStates,&stateData[0]); // states
         // Get data into local Vector and assign to State using common utility
         // to handle internal (non-OpenSim) states that may exist
-        Array<std::string> stateNames = aStatesStore.getColumnLabels();
         for (int j=0; j<stateData.size(); ++j){
-            // storage labels included time at index 0 so +1 to skip
-            aModel.setStateVariableValue(s, stateNames[j+1], stateData[j]);
+            if (stateIndices[j] >= 0)
+                aModel.setStateVariableValue(s, stateIndices[j], stateData[j]);
+            else // storage labels included time at index 0 so +1 to skip
+                aModel.setStateVariableValue(s, labels[j+1], stateData[j]);
         }
        
         // Adjust configuration to match constraints and other goals
@@ -648,9 +813,9 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         // Make sure model is atleast ready to provide kinematics
         aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
 
-        if(i==iInitial) {
+        if(i==iFirst && aBegin) {
             analysisSet.begin(s);
-        } else if(i==iFinal) {
+        } else if(i==iLast && aEnd) {
             analysisSet.end(s);
         // Step
         } else {
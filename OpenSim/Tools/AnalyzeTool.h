@@ -68,6 +68,9 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads used to analyze the frames of the states. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +122,8 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     const bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -141,6 +146,9 @@ public:
     //--------------------------------------------------------------------------
 #ifndef SWIG
     static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, int aNumThreads);
+private:
+    static void runFrames(SimTK::State& s, Model &aModel, int iFirst, int iLast, const Storage &aStatesStore, bool aSolveForEquilibrium, bool aBegin, bool aEnd);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
@@ -862,15 +862,15 @@ bool CMCTool::run()
     // ---- RESULTS -----
     printResults(getName(),getResultsDir()); // this will create results directory if necessary
     controller->updControlSet().print(getResultsDir() + "/" + getName() + "_controls.xml");
-    _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls.sto");
-    manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
+    _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls" + getResultsFileExtension());
+    manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states" + getResultsFileExtension());
     /*
     Storage statesDegrees(manager.getStateStorage());
     _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
     statesDegrees.setWriteSIMMHeader(true);
     statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
     */
-    controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
+    controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr" + getResultsFileExtension());
 
     //_model->removeController(controller); // So that if this model is from GUI it doesn't double-delete it.
 
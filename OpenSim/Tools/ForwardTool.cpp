@@ -352,8 +352,8 @@ void ForwardTool::printResults()
 
     AbstractTool::printResults(getName(),getResultsDir()); // this will create results directory if necessary
     if(_model) {
-        _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls.sto");
-        getManager().getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
+        _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls" + getResultsFileExtension());
+        getManager().getStateStorage().print(getResultsDir() + "/" + getName() + "_states" + getResultsFileExtension());
 
         Storage statesDegrees(getManager().getStateStorage());
         _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
@@ -65,6 +65,7 @@ InverseDynamicsTool::~InverseDynamicsTool()
 InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
     _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
@@ -84,6 +85,7 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     DynamicsTool(aFileName, false),
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
     _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
@@ -106,6 +108,7 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     DynamicsTool(aTool),
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
     _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
@@ -123,6 +126,7 @@ void InverseDynamicsTool::setNull()
     setupProperties();
     _model = NULL;
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
     _coordinateValues = NULL;
 }
 //_____________________________________________________________________________
@@ -141,6 +145,15 @@ void InverseDynamicsTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to solve the frames of the coordinates. With more than one thread, "
+                 "the frames are split into consecutive blocks that are solved concurrently. Frames are solved "
+                 "one after the other when the model has analyses or enabled forces with a path (muscles, "
+                 "ligaments). The coordinate splines are fit on the same number of threads. A value of 0 uses "
+                 "one thread per processor. The default value is 1.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
     _outputGenForceFileNameProp.setComment("Name of the storage file (.sto) to which the generalized forces are written.");
     _outputGenForceFileNameProp.setName("output_gen_force_file");
     _outputGenForceFileNameProp.setValue("inverse_dynamics.sto");
@@ -184,6 +197,7 @@ operator=(const InverseDynamicsTool &aTool)
     _modelFileName = aTool._modelFileName;
     _coordinatesFileName = aTool._coordinatesFileName;
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
     _coordinateValues = NULL;
@@ -278,7 +292,7 @@ bool InverseDynamicsTool::run()
                 _model->getSimbodyEngine().convertDegreesToRadians(*_coordinateValues);
             }
             // Create differentiable splines of the coordinate data
-            coordFunctions = new GCVSplineSet(5, _coordinateValues);
+            coordFunctions = new GCVSplineSet(5, _coordinateValues, 0.0, _numThreads);
 
             //Functions must correspond to model coordinates and their order for the solver
             for(int i=0; i<nq; i++){
@@ -335,6 +349,7 @@ bool InverseDynamicsTool::run()
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
+        ivdSolver.setNumThreads(_numThreads);
         ivdSolver.solve(s, *coordFunctions, times, genForceTraj);
 
 
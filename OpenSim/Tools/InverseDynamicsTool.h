@@ -27,6 +27,7 @@
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Common/PropertyBool.h>
 #include <OpenSim/Common/PropertyDbl.h>
+#include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Common/PropertyDblArray.h>
 #include <OpenSim/Common/Storage.h>
@@ -81,6 +82,10 @@ protected:
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
 
+    /** Number of threads used to solve the frames (0 for one per processor). */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     /** name of storage file containing generalized forces from innverse dynamics */
     PropertyStr _outputGenForceFileNameProp;
     std::string &_outputGenForceFileName;
@@ -162,6 +167,8 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
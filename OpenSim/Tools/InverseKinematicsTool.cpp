@@ -47,6 +47,11 @@
 
 #include "SimTKsimbody.h"
 
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -77,7 +82,9 @@ InverseKinematicsTool::InverseKinematicsTool() : Tool(),
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _chunkOverlap(_chunkOverlapProp.getValueInt())
 {
     setNull();
 }
@@ -102,7 +109,9 @@ InverseKinematicsTool::InverseKinematicsTool(const string &aFileName, bool aLoad
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _chunkOverlap(_chunkOverlapProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -130,7 +139,9 @@ InverseKinematicsTool::InverseKinematicsTool(const InverseKinematicsTool &aTool)
     _timeRange(_timeRangeProp.getValueDblArray()),
     _reportErrors(_reportErrorsProp.getValueBool()),
     _outputMotionFileName(_outputMotionFileNameProp.getValueStr()),
-    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool())
+    _reportMarkerLocations(_reportMarkerLocationsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _chunkOverlap(_chunkOverlapProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -202,6 +213,21 @@ void InverseKinematicsTool::setupProperties()
     _reportMarkerLocationsProp.setValue(false);
     _propertySet.append(&_reportMarkerLocationsProp);
 
+    _numThreadsProp.setComment("Number of threads used to solve the frames. With more than one thread, "
+        "the frames are split into consecutive chunks, each solved by its own copy of the model starting "
+        "from an assembly at its first frame. A value of 0 uses one thread per processor. "
+        "The default value is 1, so the frames are tracked one after the other.");
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append(&_numThreadsProp);
+
+    _chunkOverlapProp.setComment("Number of frames each chunk (after the first) solves before its own frames. "
+        "The solution at the last of these frames must match that of the previous chunk, otherwise the "
+        "chunk is solved again continuing from the previous chunk. Used only when num_threads is not 1.");
+    _chunkOverlapProp.setName("chunk_overlap");
+    _chunkOverlapProp.setValue(10);
+    _propertySet.append(&_chunkOverlapProp);
+
 }
 
 //_____________________________________________________________________________
@@ -239,6 +265,8 @@ operator=(const InverseKinematicsTool &aTool)
     _reportErrors = aTool._reportErrors;
     _outputMotionFileName = aTool._outputMotionFileName;
     _reportMarkerLocations = aTool._reportMarkerLocations;
+    _numThreads = aTool._numThreads;
+    _chunkOverlap = aTool._chunkOverlap;
 
     return(*this);
 }
@@ -251,6 +279,117 @@ operator=(const InverseKinematicsTool &aTool)
 //=============================================================================
 // RUN
 //=============================================================================
+// Largest difference in any q (rad or m) between the solutions of two chunks
+// at the frame where they join for the chunks to be considered continuous.
+static const double CHUNK_CONTINUITY_TOLERANCE = 1e-3;
+
+//_____________________________________________________________________________
+/**
+ * Track the frames of a trial in chunks solved concurrently.
+ *
+ * The first chunk is tracked by ikSolver on s, which must already be
+ * assembled at the first frame. Every other chunk is solved on its own
+ * thread by a copy of the model and a solver over a slice of the marker
+ * data, starting from an assembly aOverlap frames before its first frame.
+ * A chunk is kept only if its solution at the frame before its first matches
+ * that of the previous chunk; otherwise it is tracked again by ikSolver
+ * continuing from the previous chunk. The solution and, if requested, the
+ * squared marker errors and marker locations of every frame are returned.
+ */
+static void trackInChunks(const Model& aModel, SimTK::State& s,
+    InverseKinematicsSolver& ikSolver, const MarkersReference& aMarkersReference,
+    const Set<MarkerWeight>& aMarkerWeights,
+    SimTK::Array_<CoordinateReference>& aCoordinateReferences,
+    double aConstraintWeight, double aAccuracy, double aStartTime, double aDT,
+    int aNumFrames, int aNumChunks, int aOverlap,
+    bool aRecordErrors, bool aRecordLocations,
+    SimTK::Array_<SimTK::Vector>& rQ,
+    SimTK::Array_<SimTK::Array_<double> >& rSquaredMarkerErrors,
+    SimTK::Array_<SimTK::Array_<Vec3> >& rMarkerLocations)
+{
+    // Chunk k owns frames first[k] through first[k+1]-1
+    std::vector<int> first(aNumChunks+1);
+    for(int k=0; k<=aNumChunks; k++)
+        first[k] = k*aNumFrames/aNumChunks;
+
+    rQ.resize(aNumFrames);
+    if(aRecordErrors) rSquaredMarkerErrors.resize(aNumFrames);
+    if(aRecordLocations) rMarkerLocations.resize(aNumFrames);
+
+    auto trackFrames = [&](InverseKinematicsSolver& aSolver, SimTK::State& aState,
+                           int iFirst, int iEnd) {
+        for(int i=iFirst; i<iEnd; i++) {
+            aState.updTime() = aStartTime + i*aDT;
+            aSolver.track(aState);
+            rQ[i] = aState.getQ();
+            if(aRecordErrors)
+                aSolver.computeCurrentSquaredMarkerErrors(rSquaredMarkerErrors[i]);
+            if(aRecordLocations)
+                aSolver.computeCurrentMarkerLocations(rMarkerLocations[i]);
+        }
+    };
+
+    const MarkerData& markerData = aMarkersReference.getMarkerData();
+    std::vector<std::unique_ptr<Model> > models;
+    for(int k=1; k<aNumChunks; k++)
+        models.push_back(std::unique_ptr<Model>(aModel.clone()));
+
+    std::vector<SimTK::Vector> seamQ(aNumChunks);
+    std::vector<std::exception_ptr> errors(aNumChunks);
+    auto solveChunk = [&](int k) {
+        try {
+            int iSeed = first[k] - aOverlap;
+            int before=0, after=0;
+            markerData.findFrameRange(aStartTime + iSeed*aDT,
+                aStartTime + (first[k+1]-1)*aDT, before, after);
+            MarkerData slice(markerData, before-1, after+1);
+            MarkersReference markersReference(slice, &aMarkerWeights);
+
+            Model& model = *models[k-1];
+            SimTK::State& ks = model.initSystem();
+            InverseKinematicsSolver solver(model, markersReference,
+                aCoordinateReferences, aConstraintWeight);
+            solver.setAccuracy(aAccuracy);
+            ks.updTime() = aStartTime + iSeed*aDT;
+            solver.assemble(ks);
+            for(int i=iSeed; i<first[k]; i++) {
+                ks.updTime() = aStartTime + i*aDT;
+                solver.track(ks);
+            }
+            seamQ[k] = ks.getQ();
+            trackFrames(solver, ks, first[k], first[k+1]);
+        } catch(...) {
+            errors[k] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int k=1; k<aNumChunks; k++)
+        threads.push_back(std::thread(solveChunk, k));
+    try {
+        trackFrames(ikSolver, s, 0, first[1]);
+    } catch(...) {
+        errors[0] = std::current_exception();
+    }
+    for(size_t k=0; k<threads.size(); k++) threads[k].join();
+    for(int k=0; k<aNumChunks; k++)
+        if(errors[k]) std::rethrow_exception(errors[k]);
+
+    // Stitch the chunks in order, solving again any chunk that does not join
+    // the (possibly re-solved) chunk before it.
+    for(int k=1; k<aNumChunks; k++) {
+        const SimTK::Vector& q = rQ[first[k]-1];
+        if(max(abs(seamQ[k]-q)) <= CHUNK_CONTINUITY_TOLERANCE) continue;
+
+        cout << "InverseKinematicsTool: solution of frames " << first[k] << " to "
+             << first[k+1]-1 << " does not join the preceding frames; solving them again." << endl;
+        s.updTime() = aStartTime + (first[k]-1)*aDT;
+        s.updQ() = q;
+        ikSolver.assemble(s);
+        trackFrames(ikSolver, s, first[k], first[k+1]);
+    }
+}
+
 //_____________________________________________________________________________
 /**
  * Run the inverse kinematics tool.
@@ -373,16 +512,39 @@ bool InverseKinematicsTool::run()
         
         Storage *modelMarkerLocations = _reportMarkerLocations ? new Storage(Nframes, "ModelMarkerLocations") : NULL;
 
+        // With several threads, solve the frames in chunks up front and then
+        // report them in order below
+        int nThreads = _numThreads>0 ? _numThreads : (int)std::thread::hardware_concurrency();
+        int overlap = _chunkOverlap>0 ? _chunkOverlap : 1;
+        int nChunks = nThreads;
+        if(nChunks > Nframes/(2*overlap)) nChunks = Nframes/(2*overlap);
+        SimTK::Array_<SimTK::Vector> chunkQ;
+        SimTK::Array_<SimTK::Array_<double> > chunkSquaredMarkerErrors;
+        SimTK::Array_<SimTK::Array_<Vec3> > chunkMarkerLocations;
+        if(nChunks > 1) {
+            cout << "Solving " << Nframes << " frames in " << nChunks << " chunks." << endl;
+            trackInChunks(*_model, s, ikSolver, markersReference, markerWeights,
+                coordinateReferences, _constraintWeight, _accuracy, start_time, dt,
+                Nframes, nChunks, overlap, _reportErrors, _reportMarkerLocations,
+                chunkQ, chunkSquaredMarkerErrors, chunkMarkerLocations);
+        }
+
         for (int i = 0; i < Nframes; i++) {
             s.updTime() = start_time + i*dt;
-            ikSolver.track(s);
+            if(nChunks > 1)
+                s.updQ() = chunkQ[i];
+            else
+                ikSolver.track(s);
             
             if(_reportErrors){
                 double totalSquaredMarkerError = 0.0;
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+                if(nChunks > 1)
+                    squaredMarkerErrors = chunkSquaredMarkerErrors[i];
+                else
+                    ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -397,7 +559,10 @@ bool InverseKinematicsTool::run()
             }
 
             if(_reportMarkerLocations){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                if(nChunks > 1)
+                    markerLocations = chunkMarkerLocations[i];
+                else
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
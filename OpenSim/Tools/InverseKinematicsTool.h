@@ -27,6 +27,7 @@
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Common/PropertyBool.h>
 #include <OpenSim/Common/PropertyDbl.h>
+#include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Common/PropertyDblArray.h>
 #include "Tool.h"
@@ -108,6 +109,14 @@ private:
     PropertyBool _reportMarkerLocationsProp;
     bool &_reportMarkerLocations;
 
+    // number of threads solving chunks of the frames concurrently (0 for one per processor)
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
+    // number of frames each chunk solves ahead of its own frames to confirm continuity
+    PropertyInt _chunkOverlapProp;
+    int &_chunkOverlap;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -138,6 +147,12 @@ public:
 
     void setCoordinateFileName(const std::string& coordDataFileName) { _coordinateFileName=coordDataFileName;};
     const std::string& getCoordinateFileName() const { return  _coordinateFileName;};
+
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; };
+    int getNumThreads() const { return _numThreads; };
+
+    void setChunkOverlap(int aNumFrames) { _chunkOverlap = aNumFrames; };
+    int getChunkOverlap() const { return _chunkOverlap; };
     
     //const OpenSim::Storage& getOutputStorage() const;
 private:
@@ -849,15 +849,15 @@ bool RRATool::run()
     // ---- RESULTS -----
     printResults(getName(),getResultsDir()); // this will create results directory if necessary
     controller->updControlSet().print(getResultsDir() + "/" + getName() + "_controls.xml");
-    _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls.sto");
-    manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
+    _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls" + getResultsFileExtension());
+    manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states" + getResultsFileExtension());
     /*
     Storage statesDegrees(manager.getStateStorage());
     _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
     statesDegrees.setWriteSIMMHeader(true);
     statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
     */
-    controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
+    controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr" + getResultsFileExtension());
 
     stringstream adjQMsg;
     if(_model->getAnalysisSet().getIndex("Actuation") != -1) {
@@ -31,7 +31,6 @@
 #include <OpenSim/Simulation/Model/Actuator.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
-#include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/CMCActuatorSubsystem.h>
 #include "CMC.h"
@@ -50,6 +49,8 @@ using namespace std;
  */
 VectorFunctionForActuators::~VectorFunctionForActuators()
 {
+    delete _timeStepper;
+    delete _integrator;
 }
 //_____________________________________________________________________________
 /**
@@ -70,6 +71,8 @@ VectorFunctionForActuators(SimTK::System *aActuatorSystem, Model* model, CMCActu
 
     // Don't project constraints while inside the controller
     _integrator->setProjectInterpolatedStates( false );
+    _timeStepper = new SimTK::TimeStepper(*aActuatorSystem, *_integrator);
+    _actSysState = aActuatorSystem->getDefaultState();
     _f.setSize(getNX());
 }
 //_____________________________________________________________________________
@@ -106,6 +109,7 @@ setNull()
     _CMCActuatorSubsystem = NULL;
     _model             = NULL;
     _integrator        = NULL;
+    _timeStepper       = NULL;
 }
 
 //_____________________________________________________________________________
@@ -262,25 +266,19 @@ evaluate( const SimTK::State& s, double *aX, double *rF)
     CMC& controller=  dynamic_cast<CMC&>(_model->updControllerSet().get("CMC" ));
     controller.updControlSet().setControlValues(_tf, aX);
 
-    // create a Manager that will integrate just the actuator subsystem and use only the 
-    // CMC controller
-
-    Manager manager(*_model, *_integrator);
-    manager.setInitialTime(_ti);
-    manager.setFinalTime(_tf);
-    manager.setSystem( _CMCActuatorSystem );
-    // tell the mangager to not call the analayses or write to storage 
-    // while the CMCSubsystem is being integrated.
-    manager.setPerformAnalyses(false); 
-    manager.setWriteToStorage(false); 
-    SimTK::State& actSysState = _CMCActuatorSystem->updDefaultState();
-    getCMCActSubsys()->updZ(actSysState) = _model->getMultibodySystem()
+    // Integrate just the actuator subsystem with the stepper kept from the
+    // previous call.  The working state was allocated at construction and
+    // only its Z and time change between calls.
+    getCMCActSubsys()->updZ(_actSysState) = _model->getMultibodySystem()
                                             .getDefaultSubsystem().getZ(s);
-
-    actSysState.setTime(_ti);
+    _actSysState.setTime(_ti);
 
     // Integration
-    manager.integrate(actSysState, 0.000001);
+    _timeStepper->initialize(_actSysState);
+    while(_integrator->getTime() < _tf) {
+        if(_timeStepper->stepTo(_tf)==SimTK::Integrator::EndOfSimulation)
+            break;
+    }
 
     const Set<Actuator>& forceSet = controller.getActuatorSet();
     // Vector function values
@@ -70,6 +70,11 @@ protected:
     CMCActuatorSubsystem* _CMCActuatorSubsystem;
     /** Integrator. */
     SimTK::Integrator* _integrator;
+    /** Time stepper reused by every evaluation of the actuator system. */
+    SimTK::TimeStepper* _timeStepper;
+    /** Working state of the actuator system, created by the constructor and
+        reused by every evaluation. */
+    SimTK::State _actSysState;
     /** Model */
     Model* _model;
 